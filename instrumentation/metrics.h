@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef INSTRUMENTATION_METRICS_H_
+#define INSTRUMENTATION_METRICS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @file metrics.h
+ * Example interfaces for collecting metrics and exposing them to a scraper.
+ *
+ * This header defines two interfaces:
+ *
+ * 1. A registry that stores named metrics (MetricsRegistry). Instrumentation in the interface
+ *    layer, such as tracing proxies (trace.h) and health monitors (sensor_health.h), updates
+ *    metrics in the registry. No changes to the drivers themselves are required.
+ * 2. A server that exposes a snapshot of the registry in the Prometheus text exposition format
+ *    (MetricsServer).
+ *
+ * ## Keeping Scraping Off the Sample Path
+ *
+ * Metrics are updated from sampling threads and read by the server thread. Scraping must never
+ * block sampling:
+ *
+ * - Each metric value is stored in a naturally aligned 64-bit atomic. Updates use relaxed atomic
+ *   adds (counters, histogram buckets) or stores (gauges). Targets without 64-bit atomics use
+ *   the scheme described below.
+ * - Metrics updated from many threads at high rates can be sharded per thread (or per core) and
+ *   summed when the registry is rendered.
+ * - Rendering reads each value with a relaxed atomic load. The snapshot is not an atomic view of
+ *   all metrics, which is consistent with how Prometheus treats scrapes.
+ * - Names and help strings are fixed at registration, so rendering does not need to synchronize
+ *   with registration beyond an acquire load of the metric count.
+ *
+ * ### Targets Without 64-bit Atomics
+ *
+ * Some targets only provide 32-bit atomic operations (e.g., ARMv7-M, whose LDREX/STREX operate on
+ * 32-bit words). There, 64-bit atomics are implemented with a lock, which would put a lock on the
+ * sample path. On these targets, the reference implementation splits each counter into two parts:
+ *
+ * - Update functions add to a 32-bit atomic accumulator with a relaxed 32-bit atomic add.
+ * - Rendering folds each accumulator into a 64-bit total: it atomically exchanges the
+ *   accumulator with 0, and adds the old value to the total. Only the rendering thread touches
+ *   the total, so it needs no atomic operations.
+ *
+ * Totals are exact as long as each accumulator is folded before it can wrap. If scrapes are
+ * infrequent relative to the update rate, the system folds the accumulators periodically (e.g.,
+ * from a timer, see os/timer.h) using the same operation. Histogram buckets and sums are folded
+ * the same way. Gauges are stored as 32-bit atomics on these targets, which limits their range to
+ * that of int32_t.
+ *
+ * Accumulators for metrics updated from many threads can also be sharded per thread, as above,
+ * and each shard folded separately.
+ *
+ * ## Histograms
+ *
+ * Histograms use fixed power-of-two bucket boundaries (1, 2, 4, ... 2^31 in the metric's unit,
+ * plus +Inf). The bucket index for a value is computed with a count-leading-zeros instruction,
+ * so an observation costs one CLZ and two relaxed atomic adds (the bucket and the sum).
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Support labels (e.g., sensor="baro0") instead of encoding the instance in the metric name
+ * - Use configurable histogram bucket boundaries
+ * - Serve the OpenMetrics format, or push metrics to a gateway instead of being scraped
+ * - Render directly into the socket instead of into a buffer
+ */
+
+#pragma mark - Registry -
+
+/** Types of metrics supported by a MetricsRegistry */
+typedef enum
+{
+	/// A monotonically increasing value (e.g., number of samples).
+	METRIC_COUNTER = 0,
+	/// A value that can go up and down (e.g., queue depth).
+	METRIC_GAUGE,
+	/// A distribution of observed values (e.g., callback latency).
+	METRIC_HISTOGRAM,
+} MetricType;
+
+/** Virtual Metrics Registry Interface
+ *
+ * A standard interface for storing metrics that can be scraped.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - Metrics are identified by a handle, which is returned when the metric is registered.
+ * - The registry has a fixed capacity, which is specified when it is instantiated.
+ * - Metrics cannot be unregistered.
+ * - Names and help strings must follow Prometheus rules (e.g., names match
+ *   [a-zA-Z_:][a-zA-Z0-9_:]*). Names should include the unit (e.g., "baro0_callback_latency_us").
+ * - The name and help pointers must remain valid for the lifetime of the registry.
+ * - Update functions may be called from any thread, concurrently with rendering.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Registration fails if the registry is full, the name is already registered, or the name
+ *   is invalid.
+ * - Updates with an invalid handle, or with a handle for a different type of metric, are ignored.
+ *
+ * ## Implementation Notes
+ *
+ * - Update functions are on the sample path, and must be lock-free. See the file documentation.
+ */
+typedef struct
+{
+	/** Register a new metric
+	 *
+	 * @pre name and handle are not NULL.
+	 * @post If registration succeeded, the data pointed to by handle identifies the new metric.
+	 * @post If registration failed, the data pointed to by handle will remain unchanged.
+	 *
+	 * @param[in] name The metric name.
+	 * @param[in] help A description of the metric, or NULL.
+	 * @param[in] type The type of the metric.
+	 * @param[inout] handle Pointer which will be used to store the handle of the new metric.
+	 *
+	 * @returns True if the metric was registered, false if an error occurred.
+	 */
+	bool (*registerMetric)(const char* const name, const char* const help, MetricType type,
+						   uint16_t* const handle);
+
+	/** Add to a counter
+	 *
+	 * @param[in] handle The handle of a METRIC_COUNTER metric.
+	 * @param[in] value The amount to add.
+	 */
+	void (*add)(uint16_t handle, uint64_t value);
+
+	/** Set a gauge
+	 *
+	 * @param[in] handle The handle of a METRIC_GAUGE metric.
+	 * @param[in] value The new value of the gauge.
+	 */
+	void (*set)(uint16_t handle, int64_t value);
+
+	/** Record an observation in a histogram
+	 *
+	 * @param[in] handle The handle of a METRIC_HISTOGRAM metric.
+	 * @param[in] value The observed value, in the unit of the metric.
+	 */
+	void (*observe)(uint16_t handle, uint32_t value);
+
+	/** Render a snapshot of all metrics
+	 *
+	 * The snapshot is written in the Prometheus text exposition format (version 0.0.4).
+	 * The output is not NUL-terminated.
+	 *
+	 * An empty registry renders successfully, with a length of 0.
+	 *
+	 * @pre buffer and length are not NULL.
+	 * @post If the snapshot fit, the data pointed to by length holds the number of bytes written.
+	 * @post If the snapshot did not fit, the contents of the buffer and the data pointed to by
+	 *  length are undefined.
+	 *
+	 * @param[inout] buffer Storage for the rendered text.
+	 * @param[in] size The size of the buffer, in bytes.
+	 * @param[inout] length Pointer which will be used to store the number of bytes written.
+	 *
+	 * @returns True if the snapshot was rendered, false if it did not fit in the buffer.
+	 */
+	bool (*render)(char* const buffer, size_t size, size_t* const length);
+} MetricsRegistry;
+
+#pragma mark - Exposition -
+
+/** Virtual Metrics Server Interface
+ *
+ * A standard interface for a server that exposes a MetricsRegistry to a Prometheus scraper.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The server exposes exactly one MetricsRegistry, which is supplied by the system when the
+ *   server is instantiated.
+ * - The listening address (e.g., a Unix domain socket path, or a loopback port) is specified
+ *   when the server is instantiated.
+ * - The server speaks HTTP/1.0. Each connection serves a single GET request for the metrics
+ *   path, and is then closed.
+ * - The server runs on its own thread of control, and never runs on a sampling thread.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Requests for any other path or method receive a 404 or 405 response.
+ * - Malformed requests, and clients that do not send a complete request within a short timeout,
+ *   are disconnected.
+ *
+ * ## Implementation Notes
+ *
+ * - The server only needs to handle one connection at a time. Keep it small: a blocking accept()
+ *   loop with a fixed-size request buffer is sufficient.
+ * - If render() reports that the snapshot did not fit, respond with a 500 status rather than a
+ *   truncated body.
+ */
+typedef struct
+{
+	/** Start serving metrics
+	 *
+	 * @post If the server started, scrapes will be answered until stop() is called.
+	 *
+	 * @returns True if the server started, false if an error occurred (e.g., the address is in
+	 *  use).
+	 */
+	bool (*start)(void);
+
+	/** Stop serving metrics
+	 *
+	 * @post The listening socket is closed. Any in-progress scrape is completed or aborted.
+	 */
+	void (*stop)(void);
+} MetricsServer;
+
+#endif // INSTRUMENTATION_METRICS_H_
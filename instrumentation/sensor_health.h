@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef INSTRUMENTATION_SENSOR_HEALTH_H_
+#define INSTRUMENTATION_SENSOR_HEALTH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file sensor_health.h
+ * Example interface for monitoring the health of a sensor.
+ *
+ * A health monitor wraps any sensor interface with callback support (e.g.,
+ * BarometricSensor_withCb, TemperatureSensor_withCb, HumiditySensor_withCb, or
+ * BarometricSensor_asyncWithCb) and presents the same interface. Calls and samples pass through
+ * unchanged, while the monitor counts:
+ *
+ * - valid samples delivered through the "new sample" callback
+ * - invalid reads (read functions that returned false)
+ * - error callbacks issued by the sensor
+ * - the time at which the last valid sample was delivered
+ *
+ * System code can query these counters at any time to detect a sensor that has silently stopped
+ * producing samples, or that is intermittently failing.
+ *
+ * ## Keeping the Overhead Low
+ *
+ * Each sample costs at most one relaxed atomic increment and one store of a 64-bit timestamp
+ * (see the Implementation Notes for platforms without 64-bit atomics). No locks are taken on the
+ * sample path. Counters for each instance should be placed
+ * in their own cache line, so that monitors for different sensors do not contend.
+ *
+ * Staleness is not checked on the sample path. It is computed when the monitor is queried, by
+ * comparing the time since the last valid sample against the configured deadline.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Invoke the sensor's error callbacks when a sample is stale (requires a timer)
+ * - Track a windowed error rate instead of a cumulative count
+ * - Use 64-bit counters on systems where 32-bit counters could wrap between queries
+ */
+
+/** A snapshot of sensor health counters
+ *
+ * All counters are cumulative since the monitor was instantiated or last reset, and wrap on
+ * overflow. Consumers should compare successive snapshots using unsigned subtraction.
+ */
+typedef struct
+{
+	/// Number of valid samples delivered to "new sample" callbacks.
+	uint32_t samples;
+	/// Number of read calls that returned false.
+	uint32_t invalidReads;
+	/// Number of error callbacks issued by the sensor.
+	uint32_t errors;
+	/// Time since the last valid sample, in microseconds. Saturates at UINT32_MAX.
+	/// UINT32_MAX is also reported if no valid sample has been received.
+	uint32_t timeSinceLastSample;
+} SensorHealthStats;
+
+/** Virtual Sensor Health Monitor Interface
+ *
+ * A standard interface for querying a health monitor that wraps another sensor.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The monitor wraps exactly one underlying sensor with callback support, which is supplied by
+ *   the system when the monitor is instantiated.
+ * - The monitor presents the same sensor interface as the underlying sensor.
+ * - Samples, read results, and errors pass through unchanged.
+ * - The monitor has access to a monotonic time source, which is supplied when the monitor is
+ *   instantiated.
+ * - A sensor is stale if the time since its last valid sample exceeds a deadline. No deadline is
+ *   configured by default, and the sensor is never considered stale.
+ * - Queries may be made from any thread, concurrently with the sample path.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Queries never block the sample path. A snapshot is not guaranteed to be an atomic view of
+ *   all counters, but each counter is individually consistent.
+ *
+ * ## Implementation Notes
+ *
+ * - The sample path should use at most a few relaxed atomic operations per sample.
+ * - The last sample timestamp must not wrap during the lifetime of the system. A 32-bit
+ *   microsecond timestamp wraps after about 71 minutes, after which a sensor that died long ago
+ *   would appear fresh. Store a 64-bit timestamp, and compute timeSinceLastSample from it,
+ *   saturating at UINT32_MAX.
+ * - On platforms without 64-bit atomics (e.g., ARMv7-M), protect the 64-bit timestamp with a
+ *   sequence lock. The sample path is the only writer: it increments the sequence count, stores
+ *   both halves of the timestamp, and increments the sequence count again (with release
+ *   ordering). Queries retry until they read the same even sequence count before and after
+ *   reading the timestamp. The sample path never waits.
+ */
+typedef struct
+{
+	/** Get a snapshot of the health counters
+	 *
+	 * @pre stats is not NULL.
+	 * @post The data pointed to by stats holds the current counter values.
+	 *
+	 * @param[inout] stats Pointer which will be used to store the counters.
+	 */
+	void (*getStats)(SensorHealthStats* const stats);
+
+	/** Set the staleness deadline
+	 *
+	 * @param[in] deadline The maximum time between valid samples, in microseconds.
+	 *  A value of 0 disables staleness detection.
+	 */
+	void (*setStalenessDeadline)(uint32_t deadline);
+
+	/** Check whether the sensor is stale
+	 *
+	 * @returns True if a deadline is configured and the time since the last valid sample exceeds
+	 *  it, false otherwise.
+	 */
+	bool (*isStale)(void);
+
+	/** Reset the health counters
+	 *
+	 * The time of the last valid sample is not reset.
+	 *
+	 * @post The samples, invalidReads, and errors counters are 0.
+	 */
+	void (*resetStats)(void);
+} SensorHealthMonitor;
+
+#endif // INSTRUMENTATION_SENSOR_HEALTH_H_
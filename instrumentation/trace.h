@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef INSTRUMENTATION_TRACE_H_
+#define INSTRUMENTATION_TRACE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @file trace.h
+ * Example interfaces for tracing calls made through abstract interfaces.
+ *
+ * Because our interfaces are `struct`s of function pointers, any interface instance can be wrapped
+ * by a tracing proxy: a second instance of the same interface whose functions record a timestamp,
+ * call the corresponding function of the wrapped instance, record a second timestamp, and write a
+ * TraceRecord to a TraceBuffer. The system hands the proxy to application code in place of the
+ * original instance, and application code is unaware that tracing is taking place.
+ *
+ * In this example, `baro0` is the wrapped BarometricSensor, `trace0` is the TraceBuffer for the
+ * calling thread, and `cycles()` reads the CPU cycle counter:
+ *
+ * ```c
+ * static bool baro0_trace_readPressure(uint32_t* const pressure)
+ * {
+ * 	if(!trace0.isEnabled())
+ * 	{
+ * 		return baro0.readPressure(pressure);
+ * 	}
+ *
+ * 	uint64_t start = cycles();
+ * 	bool r = baro0.readPressure(pressure);
+ * 	uint64_t duration = cycles() - start;
+ *
+ * 	TraceRecord record = {
+ * 		.start = start,
+ * 		.duration = duration > UINT32_MAX ? UINT32_MAX : (uint32_t)duration,
+ * 		.instance = BARO0_TRACE_ID,
+ * 		.function = TRACE_FN_READ_PRESSURE,
+ * 		.result = r,
+ * 	};
+ * 	(void)trace0.write(&record);
+ * 	return r;
+ * }
+ * ```
+ *
+ * Proxies can be created for every function in the sensor interfaces in virtual_devices/
+ * (barometric, temperature, and humidity). The functions are identified by TraceFunctionId.
+ * Other interfaces can be traced with identifiers at or above TRACE_FN_USER_START.
+ * Implementations can also record callback dispatch, bus transactions, and asynchronous request
+ * completion, so that a full pipeline can be viewed on a timeline (see trace_export.h).
+ *
+ * ## Keeping the Overhead Low
+ *
+ * Tracing is intended to be left enabled in production. The design target is well under 20 ns per
+ * traced call:
+ *
+ * - Timestamps are taken from the CPU cycle counter (e.g., `rdtsc` on x86, `cntvct_el0` on
+ *   AArch64, DWT_CYCCNT on Cortex-M). They are not converted to time units on the hot path.
+ *   TraceBuffer::getTimestampFrequency() supplies the conversion factor to readers.
+ * - Each thread writes to its own buffer, so there is exactly one producer per buffer and no
+ *   locking is required. A single-producer, single-consumer ring with a release store of the
+ *   write index is sufficient.
+ * - TraceRecord is 16 bytes, so four records fit in a 64-byte cache line.
+ * - When the buffer is full, new records are dropped and counted. The writer never blocks.
+ * - When tracing is disabled, the proxy costs one call to isEnabled() (a relaxed load of the
+ *   flag) and a predictable branch. No timestamps are taken and write() is not called.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Overwrite the oldest records when the buffer is full ("flight recorder" mode)
+ * - Record a sample value in the trace record (requires a larger record)
+ * - Use a single shared buffer with an atomic fetch-add on the write index, if threads are few
+ * - Trace only a subset of functions, using a bitmask of enabled TraceFunctionId values
+ */
+
+/** Identifiers for traced interface functions
+ *
+ * Functions with the same name in different interfaces (e.g., readPressure() in
+ * BarometricSensor and BarometricSensor_withCb) share an identifier. The instance field of the
+ * TraceRecord identifies the specific interface instance.
+ */
+typedef enum
+{
+	TRACE_FN_READ_PRESSURE = 0,
+	TRACE_FN_READ_ALTITUDE,
+	TRACE_FN_SET_SEA_LEVEL_PRESSURE,
+	TRACE_FN_READ_SAMPLE,
+	TRACE_FN_READ_TEMPERATURE,
+	TRACE_FN_GET_HUMIDITY,
+	/// readHumidity() in HumiditySensor_withCb.
+	TRACE_FN_READ_HUMIDITY,
+	TRACE_FN_REGISTER_NEW_SAMPLE_CB,
+	TRACE_FN_UNREGISTER_NEW_SAMPLE_CB,
+	TRACE_FN_REGISTER_ERROR_CB,
+	TRACE_FN_UNREGISTER_ERROR_CB,
+	/// Dispatch of a "new sample" callback list. The span covers all callbacks in the list.
+	TRACE_FN_NEW_SAMPLE_CB_DISPATCH,
+	/// Dispatch of an error callback list. The span covers all callbacks in the list.
+	TRACE_FN_ERROR_CB_DISPATCH,
+	/// A bus transaction (e.g., an I2C or SPI transfer) performed by a driver.
+	TRACE_FN_BUS_TRANSACTION,
+	/// Completion of an asynchronous readSample() request. The span starts when the request was
+	/// submitted and ends when the sample was delivered, and may be recorded on a different
+	/// thread than the TRACE_FN_READ_SAMPLE record for the same request.
+	TRACE_FN_READ_SAMPLE_COMPLETE,
+	/// Identifiers at or above this value are available for application-defined use.
+	TRACE_FN_USER_START = 128,
+} TraceFunctionId;
+
+/** A single trace record
+ *
+ * Records a single call to an interface function.
+ */
+typedef struct
+{
+	/// Cycle counter value when the function was entered.
+	uint64_t start;
+	/// Number of cycles spent in the function. Saturates at UINT32_MAX.
+	uint32_t duration;
+	/// Identifier of the traced interface instance, assigned by the system.
+	uint16_t instance;
+	/// The function that was called (a TraceFunctionId value).
+	uint8_t function;
+	/// The return value of the function (1 for true, 0 for false), or 0 for void functions.
+	uint8_t result;
+} TraceRecord;
+
+/** Virtual Trace Buffer Interface
+ *
+ * A standard interface for a buffer that stores TraceRecords written by a tracing proxy.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - Each buffer is written by a single thread. Implementations that support multiple threads
+ *   provide a separate buffer per thread (e.g., using thread-local storage).
+ * - Each buffer is drained by a single reader thread.
+ * - The buffer has a fixed capacity, which is specified when it is instantiated.
+ * - Records are read in the order they were written.
+ * - Tracing is disabled until it is explicitly enabled.
+ *
+ * ## Undesired event assumptions
+ *
+ * - If the buffer is full, new records are dropped. The writer does not block. The number of
+ *   dropped records can be queried with getDroppedCount().
+ *
+ * ## Implementation Notes
+ *
+ * - write() is on the hot path of every traced call. It must be lock-free and wait-free, and
+ *   should be inlined into the proxy where possible.
+ * - isEnabled() is called on every traced call, including when tracing is disabled. It should
+ *   only perform a relaxed load of the enabled flag.
+ */
+typedef struct
+{
+	/** Enable or disable tracing
+	 *
+	 * @param[in] enable True to record calls, false to skip recording.
+	 */
+	void (*setEnabled)(bool enable);
+
+	/** Check whether tracing is enabled
+	 *
+	 * Proxies call this before taking timestamps, so that a disabled trace skips all other work.
+	 * The result may be stale by the time it is used, since another thread may change it.
+	 *
+	 * @returns True if tracing is enabled, false otherwise.
+	 */
+	bool (*isEnabled)(void);
+
+	/** Write a record to the buffer
+	 *
+	 * If tracing is disabled, the record is discarded and is not counted as dropped. This
+	 * handles records that were started just before tracing was disabled.
+	 *
+	 * @pre record is not NULL.
+	 * @pre This function is only called by the thread that owns the buffer.
+	 *
+	 * @param[in] record The record to write.
+	 *
+	 * @returns True if the record was stored, false if it was dropped or tracing is disabled.
+	 */
+	bool (*write)(const TraceRecord* const record);
+
+	/** Read records from the buffer
+	 *
+	 * Records that have been read are removed from the buffer.
+	 *
+	 * @pre records is not NULL.
+	 * @post Up to count of the oldest records in the buffer are copied to records.
+	 *
+	 * @param[inout] records Storage for the records that are read.
+	 * @param[in] count The maximum number of records to read.
+	 *
+	 * @returns The number of records that were read.
+	 */
+	size_t (*read)(TraceRecord* const records, size_t count);
+
+	/** Get the number of dropped records
+	 *
+	 * @returns The number of records dropped because the buffer was full. The counter will
+	 *  saturate at UINT32_MAX.
+	 */
+	uint32_t (*getDroppedCount)(void);
+
+	/** Get the frequency of the timestamp source
+	 *
+	 * Readers use this value to convert TraceRecord timestamps and durations to time units.
+	 *
+	 * @returns The number of timestamp ticks per second.
+	 */
+	uint64_t (*getTimestampFrequency)(void);
+} TraceBuffer;
+
+#endif // INSTRUMENTATION_TRACE_H_
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef INSTRUMENTATION_TRACE_EXPORT_H_
+#define INSTRUMENTATION_TRACE_EXPORT_H_
+
+#include "trace.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @file trace_export.h
+ * Example interface for exporting trace records to a timeline viewer.
+ *
+ * TraceRecords (see trace.h) are compact, but they are not very useful on their own. A trace
+ * exporter converts records drained from one or more TraceBuffers into a format that can be
+ * loaded into a timeline viewer, such as chrome://tracing or the Perfetto UI.
+ *
+ * Two output formats are common:
+ *
+ * - **Chrome Trace Event JSON**: a JSON array of event objects. This format is easy to generate
+ *   and read, but large.
+ * - **Perfetto protobuf**: a sequence of TracePacket messages, which can be generated without a
+ *   protobuf library by writing the (small number of) required fields directly. This format is
+ *   much more compact, and is preferred for long captures.
+ *
+ * The format is selected when the exporter is instantiated, along with the output destination
+ * (e.g., a file or socket).
+ *
+ * ## Record Mapping
+ *
+ * Each TraceBuffer corresponds to one thread, and is exported as one thread track.
+ *
+ * | TraceFunctionId                  | Exported as                                         |
+ * |----------------------------------|-----------------------------------------------------|
+ * | Interface functions              | Complete event ("X") named after the function       |
+ * | TRACE_FN_NEW_SAMPLE_CB_DISPATCH  | Complete event, nested under the enclosing call     |
+ * | TRACE_FN_ERROR_CB_DISPATCH       | Complete event, nested under the enclosing call     |
+ * | TRACE_FN_BUS_TRANSACTION         | Complete event in the "bus" category                |
+ * | TRACE_FN_READ_SAMPLE_COMPLETE    | Async span ("b"/"e") on a per-instance track        |
+ *
+ * readSample() requests and their completions are often recorded on different threads. Exporting
+ * completions as async spans keyed by instance shows the request latency as a single bar,
+ * so pipeline stalls are visible across threads.
+ *
+ * Records with function identifiers at or above TRACE_FN_USER_START are exported with a numeric
+ * name (e.g., "fn130"), unless a name has been supplied with setFunctionName().
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Stream records continuously instead of exporting a bounded capture
+ * - Add counter tracks (e.g., buffer fill level or dropped record count)
+ * - Add flow events linking each readSample() request to its completion
+ */
+
+/** Virtual Trace Exporter Interface
+ *
+ * A standard interface for converting TraceRecords into a timeline format.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The output format and destination are specified when the exporter is instantiated.
+ * - An export consists of a call to begin(), any number of calls to exportRecords(), and a call
+ *   to end().
+ * - Records passed to a single exportRecords() call come from a single TraceBuffer, in order.
+ * - Timestamps from all buffers use the same timestamp source, so they can be placed on a common
+ *   timeline.
+ * - Names are copied by the exporter, so the caller does not need to keep them alive.
+ *
+ * ## Undesired event assumptions
+ *
+ * - If the output destination reports an error, the current export fails. Further calls to
+ *   exportRecords() will return false until begin() is called again.
+ *
+ * ## Implementation Notes
+ *
+ * - Exporting is not on the sampling hot path. It is expected to run on a low-priority thread
+ *   that drains the trace buffers, or offline.
+ * - Timestamps should be converted to microseconds (JSON) or nanoseconds (Perfetto) using 64-bit
+ *   integer math, to avoid losing precision for long captures.
+ */
+typedef struct
+{
+	/** Assign a display name to an interface instance
+	 *
+	 * @pre name is not NULL.
+	 *
+	 * @param[in] instance The instance identifier used in TraceRecords.
+	 * @param[in] name The display name (e.g., "baro0").
+	 *
+	 * @returns True if the name was stored, false if no more names can be stored.
+	 */
+	bool (*setInstanceName)(uint16_t instance, const char* const name);
+
+	/** Assign a display name to an application-defined function identifier
+	 *
+	 * @pre name is not NULL.
+	 *
+	 * @param[in] function The function identifier, at or above TRACE_FN_USER_START.
+	 * @param[in] name The display name.
+	 *
+	 * @returns True if the name was stored, false if the identifier is invalid or no more names
+	 *  can be stored.
+	 */
+	bool (*setFunctionName)(uint8_t function, const char* const name);
+
+	/** Begin an export
+	 *
+	 * Writes any header required by the output format.
+	 *
+	 * @param[in] timestamp_frequency The number of timestamp ticks per second
+	 *  (see TraceBuffer::getTimestampFrequency()).
+	 *
+	 * @returns True if the export was started, false if an error occurred.
+	 */
+	bool (*begin)(uint64_t timestamp_frequency);
+
+	/** Export records from a single thread's trace buffer
+	 *
+	 * @pre begin() has been called.
+	 * @pre records is not NULL if count is greater than 0.
+	 *
+	 * @param[in] thread An identifier for the thread that wrote the records.
+	 * @param[in] records The records to export, in the order they were written.
+	 * @param[in] count The number of records to export.
+	 *
+	 * @returns True if the records were exported, false if an error occurred.
+	 */
+	bool (*exportRecords)(uint32_t thread, const TraceRecord* const records, size_t count);
+
+	/** End an export
+	 *
+	 * Writes any trailer required by the output format and flushes the output.
+	 *
+	 * @returns True if the export was completed, false if an error occurred.
+	 */
+	bool (*end)(void);
+} TraceExporter;
+
+#endif // INSTRUMENTATION_TRACE_EXPORT_H_
@@ -0,0 +1,282 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef INTERFACE_PATTERNS_OBSERVER_H_
+#define INTERFACE_PATTERNS_OBSERVER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/** @file observer.h
+ * Reusable observer (publish/subscribe) component.
+ *
+ * Every `_withCb` interface (e.g., BarometricSensor_withCb, TemperatureSensor_withCb,
+ * HumiditySensor_withCb) requires the implementation to keep one or more callback lists, with
+ * register, unregister, and dispatch operations. This file provides a single implementation of
+ * that pattern, which works with any callback type:
+ *
+ * - In C, OBSERVER_LIST_DECLARE() generates a list type and its subscribe/unsubscribe functions,
+ *   and OBSERVER_LIST_DISPATCH() invokes every subscriber.
+ * - In C++, the ObserverList class template provides the same operations.
+ *
+ * For example, an implementation of BarometricSensor_withCb might use:
+ *
+ * @code
+ * OBSERVER_LIST_DECLARE(PressureObservers, NewBarometricSampleCb, 4)
+ * static PressureObservers pressure_observers;
+ *
+ * static void registerNewSampleCb(const NewBarometricSampleCb callback)
+ * {
+ * 	bool added = PressureObservers_subscribe(&pressure_observers, callback);
+ * 	assert(added);
+ * }
+ *
+ * // When a new sample is available:
+ * OBSERVER_LIST_DISPATCH(PressureObservers, &pressure_observers, (pressure, altitude));
+ * @endcode
+ *
+ * ## Safe Iteration
+ *
+ * Subscribers are stored in a fixed-capacity contiguous array, along with a count of the slots
+ * in use. Dispatching can run concurrently with subscribe() and unsubscribe() without a lock and
+ * without copying the list:
+ *
+ * - subscribe() fills an empty slot, or appends a slot, storing the callback before publishing
+ *   the new count (with release ordering).
+ * - unsubscribe() clears a slot to NULL. Slots are never moved, so a dispatcher never skips or
+ *   repeats a subscriber because the list changed underneath it. Trailing empty slots are
+ *   removed from the count.
+ * - Dispatch loads the count once, then loads each slot once, skipping empty slots. Both are
+ *   loaded with acquire ordering. The acquire on a slot pairs with the release store in
+ *   subscribe(), so anything a subscriber wrote before calling subscribe() is visible to it when
+ *   it is invoked, including when it was placed in a slot freed by unsubscribe().
+ *
+ * As a result, a subscriber added during dispatch may or may not be invoked by that dispatch, and
+ * a subscriber removed during dispatch may be invoked one final time if its slot was already
+ * loaded. Every other subscriber is invoked exactly once.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Define OBSERVER_LOAD and OBSERVER_STORE for compilers that do not support the GCC atomic
+ *   builtins, or as plain accesses on single-threaded systems
+ * - Add a context pointer to each subscriber, as in os/timer.h
+ * - Allow duplicate registrations, if a callback should be invoked more than once
+ */
+
+#ifndef OBSERVER_LOAD
+#if defined(__GNUC__)
+/// Load a subscriber list field with acquire ordering.
+#define OBSERVER_LOAD(field) __atomic_load_n(&(field), __ATOMIC_ACQUIRE)
+/// Store a subscriber list field with release ordering.
+#define OBSERVER_STORE(field, value) __atomic_store_n(&(field), (value), __ATOMIC_RELEASE)
+#else
+#define OBSERVER_LOAD(field) (field)
+#define OBSERVER_STORE(field, value) ((field) = (value))
+#endif
+#endif
+
+#pragma mark - C Interface -
+
+/** Declare an observer list type and its functions
+ *
+ * Generates the following declarations:
+ *
+ * - `name`: the list type. Zero-initialize instances (e.g., declare them `static`, or initialize
+ *   them with `{0}`).
+ * - `name##_Callback`: a typedef of callback_type, used by OBSERVER_LIST_DISPATCH().
+ * - `bool name##_subscribe(name* const list, const callback_type callback)`
+ * - `void name##_unsubscribe(name* const list, const callback_type callback)`
+ *
+ * ## Fundamental Assumptions
+ *
+ * - callback_type is a function pointer type.
+ * - A callback is present on the list at most once. Subscribing a callback that is already
+ *   present has no effect, and reports success.
+ * - Calls to subscribe() and unsubscribe() on the same list are serialized by the caller
+ *   (e.g., with os/mutex.h). Dispatch may run concurrently with them. See the file documentation.
+ *
+ * ## Undesired event assumptions
+ *
+ * - subscribe() reports failure if the list is full. As with the `_withCb` interfaces, we
+ *   recommend that callers trigger an assert() or other crash in this case.
+ * - Unsubscribing a callback that is not present has no effect.
+ *
+ * ## Implementation Notes
+ *
+ * - subscribe() and unsubscribe() are O(capacity). Dispatch is O(count).
+ * - Acquire loads compile to plain loads on x86-64. On targets such as ARMv7-M, each acquire load
+ *   is followed by a barrier, so dispatch costs one barrier per slot in use. On single-threaded
+ *   systems, define OBSERVER_LOAD as a plain access to remove them.
+ *
+ * @param name The name of the generated list type, which prefixes the generated functions.
+ * @param callback_type The callback function pointer type.
+ * @param capacity The maximum number of subscribers.
+ */
+#define OBSERVER_LIST_DECLARE(name, callback_type, capacity) \
+	typedef callback_type name##_Callback; \
+	typedef struct \
+	{ \
+		callback_type subscribers[capacity]; \
+		size_t count; \
+	} name; \
+	static inline bool name##_subscribe(name* const list, const callback_type callback) \
+	{ \
+		size_t empty = (capacity); \
+		for(size_t i = 0; i < list->count; i++) \
+		{ \
+			if(list->subscribers[i] == callback) \
+			{ \
+				return true; \
+			} \
+			if(list->subscribers[i] == NULL && empty == (capacity)) \
+			{ \
+				empty = i; \
+			} \
+		} \
+		if(empty != (capacity)) \
+		{ \
+			OBSERVER_STORE(list->subscribers[empty], callback); \
+			return true; \
+		} \
+		if(list->count == (capacity)) \
+		{ \
+			return false; \
+		} \
+		OBSERVER_STORE(list->subscribers[list->count], callback); \
+		OBSERVER_STORE(list->count, list->count + 1); \
+		return true; \
+	} \
+	static inline void name##_unsubscribe(name* const list, const callback_type callback) \
+	{ \
+		size_t count = list->count; \
+		for(size_t i = 0; i < count; i++) \
+		{ \
+			if(list->subscribers[i] == callback) \
+			{ \
+				OBSERVER_STORE(list->subscribers[i], (callback_type)NULL); \
+			} \
+		} \
+		while(count > 0 && list->subscribers[count - 1] == NULL) \
+		{ \
+			count--; \
+		} \
+		OBSERVER_STORE(list->count, count); \
+	}
+
+/** Invoke every subscriber on an observer list
+ *
+ * @param name The list type name, as passed to OBSERVER_LIST_DECLARE().
+ * @param list Pointer to the list.
+ * @param args The parenthesized argument list passed to each subscriber (e.g., `(value, true)`,
+ *  or `()` for callbacks without parameters).
+ */
+#define OBSERVER_LIST_DISPATCH(name, list, args) \
+	do \
+	{ \
+		const size_t observer_count_ = OBSERVER_LOAD((list)->count); \
+		for(size_t observer_i_ = 0; observer_i_ < observer_count_; observer_i_++) \
+		{ \
+			const name##_Callback observer_cb_ = \
+				OBSERVER_LOAD((list)->subscribers[observer_i_]); \
+			if(observer_cb_ != NULL) \
+			{ \
+				observer_cb_ args; \
+			} \
+		} \
+	} while(0)
+
+#pragma mark - C++ Interface -
+
+#ifdef __cplusplus
+#include <atomic>
+
+/** Observer list class template
+ *
+ * The C++ equivalent of OBSERVER_LIST_DECLARE(), with the same assumptions and the same
+ * behavior under concurrent modification.
+ *
+ * @tparam TCallback The callback function pointer type.
+ * @tparam TCapacity The maximum number of subscribers.
+ */
+template<typename TCallback, size_t TCapacity>
+class ObserverList
+{
+  public:
+	/** Add a callback to the list
+	 *
+	 * @returns True if the callback is on the list, false if the list is full.
+	 */
+	bool subscribe(TCallback callback) noexcept
+	{
+		size_t count = count_.load(std::memory_order_relaxed);
+		size_t empty = TCapacity;
+		for(size_t i = 0; i < count; i++)
+		{
+			TCallback current = subscribers_[i].load(std::memory_order_relaxed);
+			if(current == callback)
+			{
+				return true;
+			}
+			if(current == nullptr && empty == TCapacity)
+			{
+				empty = i;
+			}
+		}
+		if(empty != TCapacity)
+		{
+			subscribers_[empty].store(callback, std::memory_order_release);
+			return true;
+		}
+		if(count == TCapacity)
+		{
+			return false;
+		}
+		subscribers_[count].store(callback, std::memory_order_release);
+		count_.store(count + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** Remove a callback from the list, if present
+	 */
+	void unsubscribe(TCallback callback) noexcept
+	{
+		size_t count = count_.load(std::memory_order_relaxed);
+		for(size_t i = 0; i < count; i++)
+		{
+			if(subscribers_[i].load(std::memory_order_relaxed) == callback)
+			{
+				subscribers_[i].store(nullptr, std::memory_order_release);
+			}
+		}
+		while(count > 0 && subscribers_[count - 1].load(std::memory_order_relaxed) == nullptr)
+		{
+			count--;
+		}
+		count_.store(count, std::memory_order_release);
+	}
+
+	/** Invoke every subscriber with the supplied arguments
+	 */
+	template<typename... TArgs>
+	void dispatch(const TArgs&... args) const
+	{
+		const size_t count = count_.load(std::memory_order_acquire);
+		for(size_t i = 0; i < count; i++)
+		{
+			const TCallback callback = subscribers_[i].load(std::memory_order_acquire);
+			if(callback != nullptr)
+			{
+				callback(args...);
+			}
+		}
+	}
+
+  private:
+	std::atomic<TCallback> subscribers_[TCapacity] = {};
+	std::atomic<size_t> count_{0};
+};
+#endif // __cplusplus
+
+#endif // INTERFACE_PATTERNS_OBSERVER_H_
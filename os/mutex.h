@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef OS_MUTEX_H_
+#define OS_MUTEX_H_
+
+#include <stdbool.h>
+
+/** @file mutex.h
+ * Example mutex interface.
+ *
+ * Implementations of the `_withCb` interfaces need to protect their callback lists, since
+ * callbacks may be registered on one thread while samples are dispatched on another. A mutex is
+ * the simplest tool for the job. Because the lock is almost never contended, the cost of the
+ * uncontended path matters far more than the cost of waiting.
+ *
+ * ## Fast Paths
+ *
+ * On Linux, the reference implementation is built directly on the futex system call rather than
+ * on pthread_mutex_t, using a single 32-bit lock word with three states (0 = unlocked,
+ * 1 = locked, 2 = locked with waiters):
+ *
+ * - lock(): a single compare-and-swap from 0 to 1. If it succeeds, no system call is made.
+ * - If the lock is held, spin for a bounded number of iterations (with a CPU pause/yield hint),
+ *   retrying the compare-and-swap. The spin limit adapts: it grows when spinning succeeded
+ *   recently and shrinks when it did not, so short critical sections avoid sleeping while long
+ *   ones do not waste CPU time.
+ * - If spinning fails, exchange the lock word to 2 and call FUTEX_WAIT until the exchange
+ *   returns 0.
+ * - unlock(): an atomic exchange to 0. FUTEX_WAKE is only called if the previous value was 2,
+ *   so an uncontended unlock makes no system call.
+ *
+ * On an RTOS, the interface maps directly to the kernel's mutex primitive, which should provide
+ * priority inheritance.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Add a timed lock function
+ * - Support recursive locking (we recommend against it)
+ * - Add a reader-writer variant, so that dispatching samples does not block other dispatchers
+ */
+
+/** Virtual Mutex Interface
+ *
+ * A standard interface for a mutual exclusion lock.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The mutex is created unlocked.
+ * - The mutex is not recursive: a thread that already holds the mutex must not lock it again.
+ * - Only the thread that locked the mutex may unlock it.
+ * - The mutex must not be used from interrupt context.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Recursive locking, or unlocking a mutex that is not held by the caller, is a programming
+ *   error. Implementations should trigger an assert() or other crash if they can detect it.
+ *
+ * ## Implementation Notes
+ *
+ * - The uncontended lock and unlock paths should not make system calls. See the file
+ *   documentation for the reference approach.
+ */
+typedef struct
+{
+	/** Lock the mutex, waiting if necessary
+	 *
+	 * @post The calling thread holds the mutex.
+	 */
+	void (*lock)(void);
+
+	/** Try to lock the mutex without waiting
+	 *
+	 * @post If the mutex was available, the calling thread holds the mutex.
+	 *
+	 * @returns True if the mutex was locked, false if it is held by another thread.
+	 */
+	bool (*tryLock)(void);
+
+	/** Unlock the mutex
+	 *
+	 * @pre The calling thread holds the mutex.
+	 * @post The mutex is unlocked, and one waiting thread (if any) is woken.
+	 */
+	void (*unlock)(void);
+} Mutex;
+
+#endif // OS_MUTEX_H_
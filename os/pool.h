@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef OS_POOL_H_
+#define OS_POOL_H_
+
+#include <stddef.h>
+
+/** @file pool.h
+ * Example fixed-block memory pool interface.
+ *
+ * Asynchronous designs create objects for every sample: readSample() requests placed on a queue
+ * (see os/queue.h), batch buffers, and timestamped sample records. Allocating these with malloc()
+ * is slow, non-deterministic, and may fragment the heap over time. Since these objects are all the
+ * same size, they can be allocated from a pool of fixed-size blocks instead.
+ *
+ * ## Lock-Free Pool with Per-Thread Caches
+ *
+ * The reference implementation allocates all of its blocks up front, and manages them in two
+ * tiers:
+ *
+ * - **Shared free list**: free blocks are linked through their first word, forming a stack.
+ *   allocate() pops from the stack and release() pushes onto it, each with a single
+ *   compare-and-swap on the head. To avoid the ABA problem, the head is paired with a counter
+ *   that is incremented on every update, and both are swapped together (a double-width CAS, or a
+ *   32-bit block index and 32-bit counter packed into one 64-bit word). Targets without a 64-bit
+ *   CAS, such as ARMv7-M (which only provides 32-bit LDREX/STREX), can pack a 16-bit block index
+ *   and a 16-bit counter into one 32-bit word, which limits the pool to 65,535 blocks. On
+ *   single-core systems, briefly masking interrupts around the update is another option.
+ * - **Per-thread caches**: each thread keeps a small array of free blocks (e.g., 32). allocate()
+ *   and release() use the cache first, which requires no atomic operations and keeps recently
+ *   used blocks in that thread's CPU cache. When the cache is empty, half of its capacity is
+ *   taken from the shared list in one operation. When it is full, half of its blocks are
+ *   returned. These transfers move a fixed number of blocks, so they do not change the
+ *   complexity of either operation.
+ *
+ * Blocks released on a different thread than the one that allocated them (e.g., a request
+ * allocated by the caller and released by the driver thread) are simply placed in the releasing
+ * thread's cache, and flow back to other threads through the shared list.
+ *
+ * Per-thread caches are updated without atomic operations, so they must never be touched from
+ * interrupt context: an interrupt handler that runs while a thread is updating its cache would
+ * corrupt it. Calls from interrupt context (detected, e.g., by reading IPSR on Cortex-M) bypass
+ * the cache and use the shared free list directly.
+ *
+ * Per-thread caches trade memory for speed: up to (threads * cache size) blocks may sit in caches
+ * while allocate() fails on another thread. Size the pool accordingly, or disable the caches on
+ * memory-constrained systems.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Use a fixed block type instead of opaque blocks, so that no casts are required
+ * - Add a blocking allocate() with a timeout (e.g., built on os/semaphore.h)
+ * - Report high-water marks and allocation failures through instrumentation/metrics.h
+ */
+
+/** Virtual Memory Pool Interface
+ *
+ * A standard interface for an allocator of fixed-size blocks.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - All blocks are the same size, which is specified when the pool is instantiated.
+ * - The number of blocks is specified when the pool is instantiated. Storage is allocated when
+ *   the pool is instantiated, and never afterward.
+ * - Blocks are aligned for any type (e.g., to alignof(max_align_t)).
+ * - allocate() and release() never block. With the reference lock-free approach, they are
+ *   amortized O(1): a compare-and-swap that loses to a concurrent update is retried, and the
+ *   number of retries is unbounded under contention. Systems that require a bounded worst case
+ *   can use interrupt masking on single-core systems (see the file documentation), which makes
+ *   both operations deterministic O(1).
+ * - allocate() and release() may be called from any thread, and from interrupt context. Calls
+ *   from interrupt context must not use a per-thread cache (see the file documentation).
+ *
+ * ## Undesired event assumptions
+ *
+ * - allocate() reports failure by returning NULL if no blocks are available.
+ * - Releasing a block that did not come from the pool, or releasing a block twice, is a
+ *   programming error. Implementations should trigger an assert() or other crash if they can
+ *   detect it.
+ *
+ * ## Implementation Notes
+ *
+ * - See the file documentation for the reference lock-free approach.
+ * - Block contents are not initialized by allocate().
+ */
+typedef struct
+{
+	/** Allocate a block
+	 *
+	 * @returns A pointer to the allocated block, or NULL if no blocks are available.
+	 */
+	void* (*allocate)(void);
+
+	/** Return a block to the pool
+	 *
+	 * @pre block was returned by allocate() on this pool, and has not been released.
+	 * @post The block may be returned by a future call to allocate().
+	 *
+	 * @param[in] block Pointer to the block to release. May be NULL, in which case the call has no
+	 *  effect.
+	 */
+	void (*release)(void* const block);
+
+	/** Get the size of each block
+	 *
+	 * @returns The size of each block, in bytes.
+	 */
+	size_t (*getBlockSize)(void);
+
+	/** Get the number of available blocks
+	 *
+	 * Blocks held in per-thread caches are counted as available.
+	 *
+	 * @returns The number of blocks that are not currently allocated. The result is only a
+	 *  snapshot.
+	 */
+	size_t (*getAvailable)(void);
+} MemoryPool;
+
+#endif // OS_POOL_H_
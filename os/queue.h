@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef OS_QUEUE_H_
+#define OS_QUEUE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/** @file queue.h
+ * Example bounded queue interface.
+ *
+ * Queues are the basic building block of asynchronous designs. For example,
+ * BarometricSensor_asyncWithCb::readSample() is expected to place a request on a queue, which is
+ * serviced by another thread of control (see barometric_sensor.h).
+ *
+ * The interface is the same regardless of how many threads access the queue. The concurrency
+ * model is a property of the implementation, and must be documented by it. Two implementations
+ * are particularly useful:
+ *
+ * - **Single-producer, single-consumer (SPSC)**: a ring buffer with a head index (written only by
+ *   the consumer) and a tail index (written only by the producer). No atomic read-modify-write
+ *   operations are required: the producer publishes an element with a release store of the tail,
+ *   and the consumer frees a slot with a release store of the head. Each side caches the other
+ *   side's index, and only reloads it when the queue appears full (or empty), which keeps the
+ *   two cache lines from bouncing between cores. This is the best choice for a driver thread
+ *   handing samples to a single processing thread.
+ * - **Bounded multi-producer, multi-consumer (MPMC)**: Dmitry Vyukov's bounded queue. Each slot
+ *   holds a sequence number alongside the element. Producers and consumers claim a position with a
+ *   compare-and-swap on the tail (or head) index, and then use the slot's sequence number to know
+ *   when the slot is ready. Each operation costs one CAS in the uncontended case, and the queue
+ *   never allocates. This is the right choice when several threads submit requests to a single
+ *   device (e.g., multiple callers of readSample()).
+ *
+ * In both cases, the capacity should be a power of two so that indices can be wrapped with a mask,
+ * and the head and tail indices should be placed on separate cache lines.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Use a fixed element type instead of copying opaque elements of a fixed size
+ * - Add blocking variants of push() and pop() with a timeout (e.g., built on os/semaphore.h)
+ * - Add batch operations, which amortize the cost of index updates over several elements
+ * - Support unbounded queues, at the cost of dynamic allocation
+ */
+
+/** Virtual Queue Interface
+ *
+ * A standard interface for a bounded, first-in, first-out queue.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The queue stores elements of a fixed size, which is specified when the queue is instantiated.
+ * - Elements are copied into and out of the queue.
+ * - The queue has a fixed capacity, which is specified when the queue is instantiated.
+ *   Storage is allocated when the queue is instantiated, and never afterward.
+ * - Elements are removed in the order they were added. (For MPMC queues, this holds for the
+ *   order in which push() operations took effect.)
+ * - push() and pop() never block.
+ * - The number of threads that may call push() and pop() concurrently is defined by the
+ *   implementation (e.g., one of each for an SPSC queue).
+ *
+ * ## Undesired event assumptions
+ *
+ * - push() reports failure if the queue is full. The element is not added.
+ * - pop() reports failure if the queue is empty.
+ *
+ * ## Implementation Notes
+ *
+ * - Lock-free implementations are strongly preferred, so that the queue can be used from
+ *   interrupt handlers and real-time threads. See the file documentation for recommended
+ *   algorithms.
+ * - getSize() may be called concurrently with push() and pop(). The result is only a snapshot.
+ */
+typedef struct
+{
+	/** Add an element to the back of the queue
+	 *
+	 * @pre element is not NULL.
+	 * @post If the queue was not full, a copy of the element is at the back of the queue.
+	 *
+	 * @param[in] element Pointer to the element to add.
+	 *
+	 * @returns True if the element was added, false if the queue is full.
+	 */
+	bool (*push)(const void* const element);
+
+	/** Remove the element at the front of the queue
+	 *
+	 * @pre element is not NULL.
+	 * @post If the queue was not empty, the data pointed to by element holds a copy of the front
+	 *       element, and the element has been removed from the queue.
+	 * @post If the queue was empty, the data pointed to by element will remain unchanged.
+	 *
+	 * @param[inout] element Pointer to storage for the removed element.
+	 *
+	 * @returns True if an element was removed, false if the queue is empty.
+	 */
+	bool (*pop)(void* const element);
+
+	/** Get the number of elements in the queue
+	 *
+	 * @returns The number of elements currently in the queue.
+	 */
+	size_t (*getSize)(void);
+
+	/** Get the capacity of the queue
+	 *
+	 * @returns The maximum number of elements that the queue can hold.
+	 */
+	size_t (*getCapacity)(void);
+} Queue;
+
+#endif // OS_QUEUE_H_
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef OS_SEMAPHORE_H_
+#define OS_SEMAPHORE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file semaphore.h
+ * Example counting semaphore interface.
+ *
+ * Semaphores are used to signal between threads of control. A common example is a driver thread
+ * that sleeps until a BarometricSensor_asyncWithCb::readSample() request has been placed on its
+ * queue (see os/queue.h): readSample() pushes the request and posts the semaphore, and the driver
+ * thread waits on the semaphore before popping requests.
+ *
+ * ## Fast Paths
+ *
+ * On Linux, the reference implementation is built directly on the futex system call, using a
+ * 32-bit count and a separate waiter count:
+ *
+ * - post(): a compare-and-swap loop that loads the count, fails without modifying it if the count
+ *   is already at the maximum, and otherwise swaps in count + 1. An unconditional atomic increment
+ *   cannot enforce the maximum. FUTEX_WAKE is only called if the waiter count is non-zero, so
+ *   posting when nobody is waiting makes no system call.
+ * - wait(): if the count is positive, a compare-and-swap decrements it and no system call is
+ *   made. Otherwise, spin briefly (as described in os/mutex.h), then increment the waiter count
+ *   and call FUTEX_WAIT while the count is 0.
+ *
+ * Timed waits use FUTEX_WAIT with a relative timeout measured against CLOCK_MONOTONIC, so they are
+ * not affected by changes to the system time.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Provide a binary semaphore (or event flag) variant
+ * - Add a function that posts the semaphore multiple times at once
+ * - Return the current count, for diagnostics
+ */
+
+/** Virtual Semaphore Interface
+ *
+ * A standard interface for a counting semaphore.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The semaphore's initial count and maximum count are specified when it is instantiated.
+ * - Any thread may post or wait on the semaphore.
+ * - post() may be called from interrupt context. Waiting functions may not.
+ * - Timeouts are specified in microseconds, and are measured against a monotonic clock.
+ *
+ * ## Undesired event assumptions
+ *
+ * - post() reports failure if the count is already at its maximum. The count is unchanged.
+ * - timedWait() reports failure if the timeout expires before the semaphore could be taken.
+ *
+ * ## Implementation Notes
+ *
+ * - post() and an uncontended wait() should not make system calls. See the file documentation for
+ *   the reference approach.
+ */
+typedef struct
+{
+	/** Increment the semaphore count
+	 *
+	 * If threads are waiting on the semaphore, one of them is woken.
+	 *
+	 * @post If the count was below its maximum, it has been incremented.
+	 *
+	 * @returns True if the count was incremented, false if it was already at its maximum.
+	 */
+	bool (*post)(void);
+
+	/** Decrement the semaphore count, waiting until it is positive
+	 *
+	 * @post The count has been decremented by the calling thread.
+	 */
+	void (*wait)(void);
+
+	/** Try to decrement the semaphore count without waiting
+	 *
+	 * @post If the count was positive, it has been decremented.
+	 *
+	 * @returns True if the count was decremented, false if it was 0.
+	 */
+	bool (*tryWait)(void);
+
+	/** Decrement the semaphore count, waiting up to a timeout
+	 *
+	 * @post If the function returns true, the count has been decremented.
+	 *
+	 * @param[in] timeout The maximum time to wait, in microseconds.
+	 *
+	 * @returns True if the count was decremented, false if the timeout expired.
+	 */
+	bool (*timedWait)(uint32_t timeout);
+} Semaphore;
+
+#endif // OS_SEMAPHORE_H_
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef OS_TIMER_H_
+#define OS_TIMER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file timer.h
+ * Example software timer service interface.
+ *
+ * Many of the components built on the sensor interfaces need timers: periodic readSample()
+ * requests (see adaptive_sampler.h), deadlines for batched callbacks, and staleness monitoring
+ * (see sensor_health.h). Rather than creating an OS timer for each, a timer service multiplexes
+ * any number of software timers onto a single hardware or OS timer.
+ *
+ * ## Hierarchical Timer Wheel
+ *
+ * The reference implementation is a hierarchical timer wheel, which supports O(1) start and
+ * cancel regardless of the number of active timers:
+ *
+ * - Time is divided into ticks of a fixed resolution (e.g., 100 µs), specified when the service
+ *   is instantiated.
+ * - The wheel has four levels of 256 slots each. Level 0 covers the next 256 ticks, level 1 the
+ *   next 256^2 ticks, and so on, for a total range of 2^32 ticks. Timers further in the future
+ *   are clamped to the last slot, and re-evaluated when they cascade.
+ * - start() picks the level from the highest bit that differs between the expiry tick and the
+ *   current tick, and appends the timer to that slot's intrusive doubly-linked list: O(1).
+ * - cancel() unlinks the timer from its slot: O(1).
+ * - On each tick, all timers in the current level 0 slot are expired. When level 0 wraps, the
+ *   next level 1 slot is cascaded: its timers are redistributed into level 0. Each timer is
+ *   cascaded at most once per level.
+ * - Timer nodes are preallocated in a fixed-capacity array (e.g., 100k entries), and handles are
+ *   indices into that array, with a generation count to detect stale handles.
+ *
+ * To keep jitter low, the wheel is driven by a single thread. On Linux, that thread sleeps with
+ * clock_nanosleep(TIMER_ABSTIME) on CLOCK_MONOTONIC (or reads a timerfd) until the next tick that
+ * has work. Empty ticks are skipped by scanning a per-level occupancy bitmap, so an idle service
+ * does not wake up on every tick. Absolute sleep times prevent drift from accumulating.
+ *
+ * The design target is 100k active timers with low expiry jitter.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Run callbacks on a worker pool, rather than on the timer thread
+ * - Add a function to restart a timer with a new delay, without cancelling it first
+ * - Use context-free callbacks, as in virtual_devices/, for small systems with few timers
+ */
+
+/** Callback function prototype for timer expiry
+ *
+ * Invoked on the timer service's thread when a timer expires. Callbacks delay every other timer,
+ * so keep them very short: set a flag, post a semaphore (os/semaphore.h), or push to a queue
+ * (os/queue.h).
+ *
+ * The callback may start and cancel timers (including its own).
+ *
+ * Callbacks receive a context pointer, since a service may manage thousands of timers (e.g., one
+ * per sensor), and generating a separate function for each one is not practical.
+ *
+ * @param[in] context The context pointer supplied when the timer was started.
+ */
+typedef void (*TimerCb)(void* context);
+
+/** Virtual Timer Service Interface
+ *
+ * A standard interface for a service that manages many software timers.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - Times are specified in microseconds, and rounded up to the service's resolution.
+ * - The maximum number of active timers is specified when the service is instantiated.
+ * - A timer never expires early. It expires on the first tick at or after its expiry time.
+ * - Timers that expire on the same tick are expired in the order they were started.
+ * - Periodic timers are rescheduled relative to their previous expiry time, not to the time the
+ *   callback ran, so they do not drift.
+ * - All functions may be called from any thread, including from timer callbacks.
+ *
+ * ## Undesired event assumptions
+ *
+ * - start() reports failure if the maximum number of active timers has been reached.
+ * - Cancelling a timer that has already expired (one-shot) or been cancelled has no effect.
+ *
+ * ## Implementation Notes
+ *
+ * - start() and cancel() must be O(1). See the file documentation for the reference approach.
+ * - If a timer is cancelled while its callback is running on the timer thread, the callback
+ *   completes, but the timer will not expire again.
+ */
+typedef struct
+{
+	/** Start a timer
+	 *
+	 * @pre callback is not NULL.
+	 * @pre handle is not NULL.
+	 * @post If the timer was started, the data pointed to by handle identifies the timer.
+	 * @post If the timer could not be started, the data pointed to by handle will remain
+	 *  unchanged.
+	 *
+	 * @param[in] delay Time until the first expiry, in microseconds.
+	 * @param[in] period Time between subsequent expiries, in microseconds. 0 for a one-shot timer.
+	 * @param[in] callback The function to invoke when the timer expires.
+	 * @param[in] context A pointer passed to the callback. May be NULL.
+	 * @param[inout] handle Pointer which will be used to store the handle of the timer.
+	 *
+	 * @returns True if the timer was started, false if no more timers can be started.
+	 */
+	bool (*start)(uint32_t delay, uint32_t period, TimerCb callback, void* context,
+				  uint32_t* const handle);
+
+	/** Cancel a timer
+	 *
+	 * @post The timer will not expire again.
+	 *
+	 * @param[in] handle The handle of the timer to cancel.
+	 */
+	void (*cancel)(uint32_t handle);
+
+	/** Get the current time
+	 *
+	 * @returns The time since the service was started, in microseconds.
+	 */
+	uint64_t (*now)(void);
+} TimerService;
+
+#endif // OS_TIMER_H_
@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef SIMULATION_BAROMETRIC_SIMULATOR_H_
+#define SIMULATION_BAROMETRIC_SIMULATOR_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @file barometric_simulator.h
+ * Example interface for controlling a simulated barometric sensor.
+ *
+ * A simulated barometric sensor implements BarometricSensor, BarometricSensor_withCb, or
+ * BarometricSensor_asyncWithCb (see barometric_sensor.h) without any hardware. It follows a
+ * trajectory (altitude over time) through a model of the International Standard Atmosphere
+ * (ISA), and adds configurable noise and temperature effects. Application code uses the
+ * simulated sensor exactly as it would use a real one.
+ *
+ * The interface defined here is used by test and simulation code to control the simulator.
+ *
+ * ## Atmosphere Model
+ *
+ * In the troposphere, ISA pressure at altitude h is:
+ *
+ *     p = p0 * (1 - L * h / T0) ^ (g * M / (R * L))
+ *
+ * Evaluating the power function per sample is too slow for load testing, which generates large
+ * batches of samples. The reference implementation precomputes two tables when the simulator is
+ * created, and linearly interpolates between entries:
+ *
+ * - **Forward table**: pressure (UQ22.10) at fixed altitude steps (e.g., every 64 m from -500 m
+ *   to 11,000 m), for the standard sea level pressure of 1013.25 hPa. The true altitude from the
+ *   trajectory is converted to the true pressure with one multiply and one shift.
+ * - **Inverse table**: altitude (Q21.10) at fixed steps of the pressure ratio r = p / slp. Since
+ *   ISA altitude depends only on this ratio, a single table serves every sea level pressure
+ *   setting. The ratio is computed as ((uint64_t)p << 30) / slp, in format UQ2.30. The ratio
+ *   exceeds 1.0 whenever the pressure is above the sea level pressure setting (below sea level,
+ *   on positive noise, or when slp is set too low), so a format with an integer part is
+ *   required. The table covers 0.125 <= r <= 1.25 in steps of 2^-10 (1153 entries):
+ *   the index is (r - (1 << 27)) >> 20, and the low 20 bits of r are the interpolation
+ *   fraction. This range includes the forward table's range (r = 0.22 to 1.06 at standard sea
+ *   level pressure), and still covers it for sea level pressure settings down to about 860 hPa.
+ *
+ * Each sample is produced in the same order as on a real device:
+ *
+ * 1. The true pressure is computed from the trajectory with the forward table.
+ * 2. Temperature effects and noise are applied to the pressure (see below).
+ * 3. The reported altitude is derived from the noisy pressure and the sea level pressure set
+ *    through the sensor interface: one divide to form the ratio, then interpolation in the
+ *    inverse table.
+ *
+ * As a result, each (pressure, altitude) pair is consistent, altitude noise follows from pressure
+ * noise exactly as it does on hardware, and an incorrect sea level pressure setting produces an
+ * altitude offset rather than a pressure change. This makes the simulator suitable for exercising
+ * altitude consumers such as altitude_estimator.h and variometer.h.
+ *
+ * The trajectory is also evaluated by linear interpolation between points. Because samples are
+ * produced at a fixed period, the per-sample altitude step within a segment is constant and is
+ * added incrementally.
+ *
+ * ## Noise and Temperature Effects
+ *
+ * - Noise is generated with a xorshift PRNG, seeded for reproducibility. An approximately Gaussian
+ *   distribution is produced by summing four uniform values (Irwin-Hall), scaled by the
+ *   configured standard deviation. No floating point is required.
+ * - A deviation from the ISA temperature changes the pressure lapse rate. The simulator applies
+ *   this as a gain on (p0 - p), computed once whenever the temperature deviation is changed.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Support the stratosphere (above 11,000 m), which uses an exponential model
+ * - Add slow sea level pressure changes (weather) to the simulation
+ * - Model sensor quantization and conversion time for specific parts
+ * - Drive the simulation from a virtual clock rather than the sample period
+ */
+
+/** A point on a simulated trajectory */
+typedef struct
+{
+	/// Time since the start of the trajectory, in milliseconds.
+	uint32_t time;
+	/// Altitude at this time, in meters. Specified as a signed 32-bit fixed-point number in
+	/// format Q21.10.
+	int32_t altitude;
+} SimTrajectoryPoint;
+
+/** Simulated Barometric Sensor Control Interface
+ *
+ * A standard interface for controlling a simulated barometric sensor.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The simulator produces samples at a fixed simulated sample period, which is specified when
+ *   the simulator is instantiated.
+ * - Simulated time advances by one sample period for each sample produced. It does not depend on
+ *   wall-clock time.
+ * - The simulator starts at an altitude of 0 m, at sea level pressure, with no noise and no
+ *   temperature deviation.
+ * - Trajectory points are supplied in increasing time order. The simulator copies the points.
+ * - After the last trajectory point, the altitude remains at the last point's altitude.
+ * - Pressure and altitude use the same units and fixed-point formats as barometric_sensor.h.
+ * - The simulated atmosphere always uses the standard sea level pressure of 1013.25 hPa. Sea
+ *   level pressure set through the sensor interface only changes the reported altitude, which
+ *   is derived from the reported pressure, as described in the file documentation.
+ * - With the same seed, trajectory, and settings, the simulator produces bit-identical samples.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Trajectories that are empty, out of order, or larger than the simulator's capacity are
+ *   rejected, and the current trajectory remains in use.
+ * - Altitudes and pressure ratios outside of the precomputed tables are clamped to the table
+ *   bounds.
+ *
+ * ## Implementation Notes
+ *
+ * - Sample generation must use integer operations only. See the file documentation for the
+ *   reference approach.
+ */
+typedef struct
+{
+	/** Set the trajectory to follow
+	 *
+	 * Simulated time is reset to the start of the new trajectory.
+	 *
+	 * @pre points is not NULL.
+	 *
+	 * @param[in] points The trajectory points, in increasing time order.
+	 * @param[in] count The number of points.
+	 *
+	 * @returns True if the trajectory was accepted, false if it is invalid.
+	 */
+	bool (*setTrajectory)(const SimTrajectoryPoint* const points, size_t count);
+
+	/** Set the pressure noise level
+	 *
+	 * @param[in] stddev The standard deviation of the pressure noise in hPa.
+	 *  Specified as an unsigned 32-bit fixed-point number in format UQ22.10. 0 disables noise.
+	 */
+	void (*setNoise)(uint32_t stddev);
+
+	/** Set the deviation from ISA temperature
+	 *
+	 * @param[in] deviation The difference between the simulated air temperature and the ISA
+	 *  temperature, in °C. Specified as a signed 16-bit fixed-point number in format Q7.8.
+	 */
+	void (*setTemperatureDeviation)(int16_t deviation);
+
+	/** Seed the noise generator
+	 *
+	 * @param[in] seed The PRNG seed. A seed of 0 is replaced with an implementation-defined
+	 *  non-zero value.
+	 */
+	void (*setSeed)(uint64_t seed);
+
+	/** Generate a batch of samples
+	 *
+	 * This function is intended for load testing, where calling through the sensor interface once
+	 * per sample would dominate the cost. Samples are produced exactly as they would be through
+	 * the sensor interface, and simulated time advances by count sample periods. Callbacks are not
+	 * invoked for batch samples.
+	 *
+	 * @pre pressure is not NULL if count is greater than 0.
+	 * @post pressure and altitude (if not NULL) hold count consecutive samples.
+	 *
+	 * @param[inout] pressure Storage for the pressure samples, in UQ22.10 hPa.
+	 * @param[inout] altitude Storage for the altitude samples, in Q21.10 m, each derived from the
+	 *  corresponding pressure sample. May be NULL.
+	 * @param[in] count The number of samples to generate.
+	 */
+	void (*generateSamples)(uint32_t* const pressure, int32_t* const altitude, size_t count);
+} BarometricSimulator;
+
+#endif // SIMULATION_BAROMETRIC_SIMULATOR_H_
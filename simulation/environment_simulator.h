@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef SIMULATION_ENVIRONMENT_SIMULATOR_H_
+#define SIMULATION_ENVIRONMENT_SIMULATOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file environment_simulator.h
+ * Example interface for controlling a bank of simulated temperature and humidity sensors.
+ *
+ * An environment simulator owns a (potentially very large) number of simulated sensor instances.
+ * Each instance implements TemperatureSensor_withCb (see temperature_sensor.h) and
+ * HumiditySensor_withCb (see humidity_sensor.h), so application code uses them exactly as it
+ * would use real sensors. Alongside the barometric simulator (barometric_simulator.h), this
+ * allows a complete sensor pipeline to be exercised without hardware.
+ *
+ * The interface defined here is used by test and simulation code to control the environment
+ * that all of the instances observe.
+ *
+ * ## Environment Model
+ *
+ * - The ambient temperature and humidity follow a diurnal (daily) cycle: a sinusoid around a
+ *   configured mean, with a configured amplitude. The sinusoid is evaluated with a small lookup
+ *   table, once per step, and is shared by all instances.
+ * - Each instance responds to the ambient conditions with a first-order lag, representing the
+ *   thermal mass of its enclosure:
+ *
+ *       value += (int32_t)(((int64_t)(ambient - value) * k) >> 16);   // k in UQ16.16
+ *
+ *   Where k = 1 - e^(-dt / tau) is the exact discrete-time factor for a step of dt. Unlike the
+ *   approximation k = dt / tau, it never exceeds 1.0, so the lag settles without overshoot or
+ *   oscillation even when a single step() is longer than tau. The product is formed in 64 bits,
+ *   since (ambient - value) * k does not fit in 32 bits once k approaches 1.0.
+ *
+ * - Each instance adds its own noise, from a per-instance xorshift PRNG state.
+ * - Temperature is quantized to Q7.8 and humidity is rounded to a whole percentage when it is
+ *   reported, matching the sensor interfaces.
+ *
+ * ## Scaling to Many Instances
+ *
+ * The simulator is designed to support tens of thousands of instances per process:
+ *
+ * - Instance state is stored as a structure of arrays (one array of temperatures, one of
+ *   humidities, one of PRNG states, and so on), rather than an array of structures. The step()
+ *   update is then a simple loop over contiguous int32_t arrays that the compiler can
+ *   auto-vectorize.
+ * - Per-instance "k" factors depend on the step size. They are recomputed (e.g., from a lookup
+ *   table of e^(-x)) only when step() is called with a different elapsed time than the previous
+ *   call, so a simulation with a constant step size pays this cost once.
+ * - Callbacks are not invoked from step(). Sample delivery happens when a simulated sensor is
+ *   read, so a step does not fan out into thousands of callbacks.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Give groups of instances different ambient conditions (e.g., indoor and outdoor)
+ * - Couple humidity to temperature, so relative humidity falls as an enclosure warms up
+ * - Invoke "new sample" callbacks from step() for instances with registered callbacks
+ * - Model sensor self-heating
+ */
+
+/** Simulated Environment Control Interface
+ *
+ * A standard interface for controlling a bank of simulated temperature and humidity sensors.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The number of instances and each instance's time constant and noise level are specified when
+ *   the simulator is instantiated.
+ * - Simulated time only advances when step() is called. It does not depend on wall-clock time.
+ * - Instances start at the mean ambient conditions.
+ * - The default environment is 20 °C and 50 %RH, with no diurnal cycle.
+ * - step() may advance time by any amount. Instances settle toward the ambient conditions
+ *   without overshoot, regardless of the step size.
+ * - The diurnal cycle has a period of 24 simulated hours, and starts at its minimum (dawn) at
+ *   simulated time 0.
+ * - Reading a simulated sensor returns the instance's value as of the most recent step().
+ * - With the same seed and the same sequence of calls, the simulator produces bit-identical
+ *   samples.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Humidity values are clamped to [0, 100] %RH, and temperature values are clamped to the
+ *   Q7.8 range.
+ *
+ * ## Implementation Notes
+ *
+ * - step() must use integer operations only, and should be written so that the per-instance
+ *   loop can be vectorized. See the file documentation for the reference approach.
+ */
+typedef struct
+{
+	/** Set the mean ambient conditions
+	 *
+	 * @param[in] temperature The mean ambient temperature in °C.
+	 *  Specified as a signed 16-bit fixed-point number in format Q7.8.
+	 * @param[in] humidity The mean ambient relative humidity, as a whole percentage.
+	 */
+	void (*setAmbient)(int16_t temperature, uint8_t humidity);
+
+	/** Set the amplitude of the diurnal cycle
+	 *
+	 * @param[in] temperature_amplitude The peak deviation from the mean temperature in °C.
+	 *  Specified as a signed 16-bit fixed-point number in format Q7.8. 0 disables the cycle.
+	 * @param[in] humidity_amplitude The peak deviation from the mean humidity, in %RH.
+	 *  Humidity varies inversely with temperature over the cycle.
+	 */
+	void (*setDiurnalAmplitude)(int16_t temperature_amplitude, uint8_t humidity_amplitude);
+
+	/** Seed the noise generators
+	 *
+	 * Each instance's PRNG is derived from this seed and the instance index.
+	 *
+	 * @param[in] seed The PRNG seed.
+	 */
+	void (*setSeed)(uint64_t seed);
+
+	/** Advance simulated time
+	 *
+	 * Updates the ambient conditions and every instance in a single batch.
+	 *
+	 * @param[in] elapsed The amount of simulated time to advance, in milliseconds.
+	 */
+	void (*step)(uint32_t elapsed);
+
+	/** Get the number of simulated instances
+	 *
+	 * @returns The number of instances managed by the simulator.
+	 */
+	uint32_t (*getInstanceCount)(void);
+} EnvironmentSimulator;
+
+#endif // SIMULATION_ENVIRONMENT_SIMULATOR_H_
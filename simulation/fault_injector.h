@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef SIMULATION_FAULT_INJECTOR_H_
+#define SIMULATION_FAULT_INJECTOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file fault_injector.h
+ * Example interface for controlling a fault-injection proxy.
+ *
+ * Error paths are rarely exercised with real hardware, so their performance problems (such as
+ * retry storms) often go unnoticed. A fault-injection proxy wraps any sensor interface (e.g.,
+ * BarometricSensor_asyncWithCb, TemperatureSensor_withCb, HumiditySensor_withCb) and presents the
+ * same interface. Calls are passed through to the wrapped instance, but the proxy can:
+ *
+ * - delay calls, or the delivery of samples, by a random latency
+ * - turn a valid read into an invalid read (the read function returns false)
+ * - issue error callbacks (e.g., BarometricErrorCb) instead of delivering a sample
+ * - reject readSample() requests as if the queue were full
+ *
+ * All decisions are made with a seeded PRNG, so a degraded-mode benchmark can be repeated
+ * exactly.
+ *
+ * ## Fault Model
+ *
+ * Each fault is controlled by a probability, specified as an unsigned 16-bit fixed-point number
+ * in format UQ0.16 (so 0x8000 is 50%, and 0xFFFF is as close to 100% as the format allows).
+ * A fault is injected when the next 16 bits from the PRNG are less than the probability, which
+ * costs one PRNG step (a few shifts and XORs) and one compare.
+ *
+ * Latency is drawn uniformly from [minLatency, maxLatency] using the same PRNG. For blocking
+ * interfaces, the proxy delays the call before returning. For callback and asynchronous
+ * interfaces, the proxy delays the delivery of the sample (or error) instead, so the caller is not
+ * blocked.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Support other latency distributions (e.g., exponential, or a table-driven empirical
+ *   distribution captured from real hardware)
+ * - Inject bursts of faults, to model a sensor that fails for a period of time
+ * - Corrupt sample values (e.g., stuck-at or spikes) to exercise the filters in virtual_devices/
+ * - Replay a recorded fault schedule instead of using a PRNG
+ */
+
+/** Fault injection settings */
+typedef struct
+{
+	/// Probability that a read returns false, in UQ0.16.
+	uint16_t invalidReadProbability;
+	/// Probability that a sample is replaced by error callbacks, in UQ0.16.
+	uint16_t errorProbability;
+	/// Probability that a readSample() request is rejected as if the queue were full, in UQ0.16.
+	uint16_t queueFullProbability;
+	/// Minimum injected latency, in microseconds.
+	uint32_t minLatency;
+	/// Maximum injected latency, in microseconds. 0 disables latency injection.
+	uint32_t maxLatency;
+} FaultInjectionSettings;
+
+/** Fault injection counters
+ *
+ * All counters are cumulative since the proxy was instantiated or the seed was last set, and wrap
+ * on overflow.
+ */
+typedef struct
+{
+	/// Number of calls passed through the proxy.
+	uint32_t calls;
+	/// Number of injected invalid reads.
+	uint32_t invalidReads;
+	/// Number of injected error callbacks.
+	uint32_t errors;
+	/// Number of injected queue-full rejections.
+	uint32_t queueFull;
+	/// Total injected latency, in microseconds.
+	uint64_t latency;
+} FaultInjectionStats;
+
+/** Fault Injection Proxy Control Interface
+ *
+ * A standard interface for controlling a fault-injection proxy that wraps another sensor.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The proxy wraps exactly one underlying sensor instance, which is supplied by the system when
+ *   the proxy is instantiated.
+ * - The proxy presents the same sensor interface as the underlying sensor.
+ * - Faults that do not apply to the wrapped interface are ignored (e.g., queue-full rejections
+ *   for interfaces without readSample(), or error callbacks for interfaces without callbacks).
+ * - The proxy has access to a time source for delays, which is supplied when the proxy is
+ *   instantiated.
+ * - No faults are injected until settings are supplied.
+ * - Faults are decided in a fixed order for each call (queue-full, latency, invalid read, error),
+ *   so that a given seed always produces the same fault sequence for the same sequence of calls.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Settings with minLatency greater than maxLatency are rejected, and the current settings remain
+ *   in use.
+ * - Faults reported by the underlying sensor are passed through unchanged, and are not counted.
+ *
+ * ## Implementation Notes
+ *
+ * - When no faults are configured, the proxy should add no more than a few instructions to each
+ *   call, so it can be left in place for baseline benchmarks.
+ */
+typedef struct
+{
+	/** Set the fault injection settings
+	 *
+	 * @pre settings is not NULL.
+	 * @post If the settings are valid, subsequent calls use the new settings.
+	 *
+	 * @param[in] settings The new settings. The proxy copies the settings.
+	 *
+	 * @returns True if the settings were applied, false if they are invalid.
+	 */
+	bool (*setSettings)(const FaultInjectionSettings* const settings);
+
+	/** Seed the fault PRNG
+	 *
+	 * The fault counters are reset.
+	 *
+	 * @param[in] seed The PRNG seed. A seed of 0 is replaced with an implementation-defined
+	 *  non-zero value.
+	 */
+	void (*setSeed)(uint64_t seed);
+
+	/** Get the fault injection counters
+	 *
+	 * @pre stats is not NULL.
+	 * @post The data pointed to by stats holds the current counter values.
+	 *
+	 * @param[inout] stats Pointer which will be used to store the counters.
+	 */
+	void (*getStats)(FaultInjectionStats* const stats);
+} FaultInjector;
+
+#endif // SIMULATION_FAULT_INJECTOR_H_
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef SIMULATION_FLEET_HARNESS_H_
+#define SIMULATION_FLEET_HARNESS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file fleet_harness.h
+ * Example interface for a large-scale sensor fleet simulation harness.
+ *
+ * A fleet harness measures how a sample-processing stack scales with the number of sensors and
+ * subscribers. It instantiates thousands of simulated devices:
+ *
+ * - BarometricSensor_asyncWithCb instances, backed by the barometric simulator
+ *   (barometric_simulator.h)
+ * - TemperatureSensor_withCb and HumiditySensor_withCb instances, backed by the environment
+ *   simulator (environment_simulator.h)
+ *
+ * The harness shards the devices across worker threads, registers the configured number of
+ * subscriber callbacks with each device, drives the devices for the configured duration, and
+ * reports throughput, latency, and CPU utilization. A sweep over sensor counts and subscriber
+ * counts is performed by calling run() repeatedly with different configurations.
+ *
+ * ## Measurement Approach
+ *
+ * - Each worker thread owns a contiguous shard of devices, and is pinned to its own core (when
+ *   pinning is enabled). Devices are never shared between threads, so the harness itself does
+ *   not introduce contention.
+ * - End-to-end latency is measured from the point a sample is requested (readSample(), or the
+ *   read function for callback devices) to the point the last subscriber callback returns.
+ * - Latencies are recorded in per-thread log-linear histograms (e.g., 8 linear sub-buckets per
+ *   power of two), which take constant memory and O(1) time per sample. Histograms are merged
+ *   when the run completes, and percentiles are computed from the merged histogram.
+ * - Per-core utilization is computed from per-thread CPU time (e.g., CLOCK_THREAD_CPUTIME_ID)
+ *   divided by the wall-clock duration of the run.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Report results per device type, rather than for the fleet as a whole
+ * - Add dedicated subscriber threads, to measure the cost of handing samples off through a queue
+ * - Enable fault injection (fault_injector.h) on a fraction of the fleet
+ * - Stream intermediate results during long runs
+ */
+
+/** Fleet simulation configuration */
+typedef struct
+{
+	/// Number of simulated BarometricSensor_asyncWithCb devices.
+	uint32_t barometricSensors;
+	/// Number of simulated TemperatureSensor_withCb devices.
+	uint32_t temperatureSensors;
+	/// Number of simulated HumiditySensor_withCb devices.
+	uint32_t humiditySensors;
+	/// Number of "new sample" callbacks registered with each device.
+	uint16_t subscribersPerSensor;
+	/// Number of worker threads. 0 uses one thread per available core.
+	uint16_t threads;
+	/// Pin each worker thread to its own core.
+	bool pinThreads;
+	/// Duration of the run, in milliseconds.
+	uint32_t duration;
+} FleetConfiguration;
+
+/** Fleet simulation results */
+typedef struct
+{
+	/// Total number of samples delivered to subscribers.
+	uint64_t samples;
+	/// Delivered samples per second, averaged over the run.
+	uint64_t samplesPerSecond;
+	/// Median end-to-end latency, in nanoseconds.
+	uint32_t latencyP50;
+	/// 90th percentile end-to-end latency, in nanoseconds.
+	uint32_t latencyP90;
+	/// 99th percentile end-to-end latency, in nanoseconds.
+	uint32_t latencyP99;
+	/// 99.9th percentile end-to-end latency, in nanoseconds.
+	uint32_t latencyP999;
+	/// Maximum end-to-end latency, in nanoseconds.
+	uint32_t latencyMax;
+	/// Number of worker threads used. Utilization can be queried for each of them.
+	uint16_t threads;
+} FleetResults;
+
+/** Fleet Simulation Harness Interface
+ *
+ * A standard interface for running fleet-scale simulations.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - Only one run can be in progress at a time. run() blocks until the run is complete.
+ * - Simulated devices are created at the start of each run and destroyed at the end.
+ * - Devices are sampled as quickly as possible (the simulators do not wait for real conversion
+ *   times), so the results reflect the cost of the processing stack.
+ * - The processing stack under test is attached by the system, by supplying the subscriber
+ *   callbacks when the harness is instantiated.
+ *
+ * ## Undesired event assumptions
+ *
+ * - If a configuration cannot be satisfied (e.g., not enough memory for the requested number of
+ *   devices, or pinning is not supported), run() fails without sampling any devices.
+ * - Latencies beyond the range of the histograms are counted in an overflow bucket, and reported
+ *   as UINT32_MAX.
+ *
+ * ## Implementation Notes
+ *
+ * - Measurement must not perturb the results: avoid shared counters and locks on the sample path.
+ *   See the file documentation for the reference approach.
+ */
+typedef struct
+{
+	/** Run a fleet simulation
+	 *
+	 * @pre config and results are not NULL.
+	 * @post If the run succeeded, the data pointed to by results holds the results of the run.
+	 * @post If the run failed, the data pointed to by results will remain unchanged.
+	 *
+	 * @param[in] config The configuration to simulate.
+	 * @param[inout] results Pointer which will be used to store the results.
+	 *
+	 * @returns True if the run succeeded, false if the configuration could not be satisfied.
+	 */
+	bool (*run)(const FleetConfiguration* const config, FleetResults* const results);
+
+	/** Get the CPU utilization of a worker thread in the most recent run
+	 *
+	 * @pre utilization is not NULL.
+	 * @post If thread is valid, the data pointed to by utilization is updated.
+	 *
+	 * @param[in] thread The worker thread index, from 0 to FleetResults::threads - 1.
+	 * @param[inout] utilization The fraction of the run that the thread spent on the CPU.
+	 *  Specified as an unsigned 16-bit fixed-point number in format UQ0.16.
+	 * @param[inout] core The core the thread was pinned to, or UINT16_MAX if it was not pinned.
+	 *  May be NULL.
+	 *
+	 * @returns True if thread is valid, false otherwise.
+	 */
+	bool (*getThreadUtilization)(uint16_t thread, uint16_t* const utilization,
+								 uint16_t* const core);
+} FleetHarness;
+
+#endif // SIMULATION_FLEET_HARNESS_H_
@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef SIMULATION_VIRTUAL_CLOCK_H_
+#define SIMULATION_VIRTUAL_CLOCK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file virtual_clock.h
+ * Example interface for a deterministic virtual clock and event scheduler.
+ *
+ * Simulations that wait on wall-clock timers are slow (they wait for real conversion times) and
+ * nondeterministic (thread scheduling changes the order of events). A virtual clock replaces
+ * wall-clock time for simulated implementations of the callback and asynchronous interfaces:
+ *
+ * - A simulated BarometricSensor_asyncWithCb schedules its sample completion for
+ *   now() + conversion time, instead of sleeping.
+ * - A periodic sampler schedules its next readSample() request for now() + period.
+ * - A fault injector (fault_injector.h) is given the virtual clock's now() as the time source
+ *   for its injected delays.
+ *
+ * The simulators do not read the clock, since each has its own notion of simulated time. They
+ * are attached by scheduling events that drive them:
+ *
+ * - environment_simulator.h advances only when step() is called. A periodic event calls
+ *   step(period) and reschedules itself for now() + period.
+ * - barometric_simulator.h advances one sample period per sample. Scheduling its reads at the
+ *   same period keeps its time in step with the clock.
+ *
+ * When the scheduler runs, virtual time jumps directly to the next event, without waiting. The
+ * cost of a simulation depends on the number of events and the work their callbacks do, not on
+ * the amount of virtual time that passes.
+ *
+ * ## Determinism
+ *
+ * - The scheduler runs on a single thread. Callbacks run one at a time, in event order.
+ * - Events are ordered by time. Events scheduled for the same time run in the order they were
+ *   scheduled (ties are broken with a monotonically increasing sequence number).
+ * - Virtual time never depends on wall-clock time.
+ *
+ * With the same initial state and the same seeds, every run produces bit-identical results.
+ *
+ * ## Implementation Notes
+ *
+ * The reference implementation stores events in a fixed-capacity array of event slots, and keeps
+ * a binary min-heap of slot indices keyed on (time, sequence), which gives O(log n) schedule and
+ * run. Cancellation marks the event's slot as cancelled in place (O(1)); cancelled events are
+ * discarded, and their slots freed, when they reach the top of the heap. For very large numbers
+ * of periodic events, a hierarchical timer wheel can be used instead (see os/timer.h).
+ *
+ * Handles combine the slot index (low bits) with a generation count (high bits) that is
+ * incremented each time the slot is freed. cancel() ignores a handle whose generation does not
+ * match its slot, so a stale handle can never cancel an unrelated event that reused the slot.
+ *
+ * Because cancelled events keep their slots until they reach the top of the heap, a simulation
+ * that cancels many far-future events can fill the event array while few events are actually
+ * pending. Implementations can rebuild the heap without cancelled events (O(n)) before reporting
+ * that schedule() has failed.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Support running in real time (scaled), for interactive simulations
+ * - Add periodic events, so that periodic callbacks do not need to reschedule themselves
+ * - Run independent partitions of a simulation on separate threads, each with its own clock, and
+ *   synchronize them at fixed intervals
+ */
+
+/** Callback function prototype for virtual clock events
+ *
+ * Invoked by the scheduler when virtual time reaches the scheduled time of the event.
+ *
+ * Unlike the callbacks in virtual_devices/, this callback receives a context pointer. A
+ * simulation may have thousands of simulated devices, and generating a separate function for
+ * each one is not practical.
+ *
+ * The callback may schedule and cancel events (including rescheduling itself).
+ *
+ * @param[in] context The context pointer supplied when the event was scheduled.
+ */
+typedef void (*VirtualClockEventCb)(void* context);
+
+/** Virtual Clock Interface
+ *
+ * A standard interface for a deterministic virtual clock and event scheduler.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - Virtual time is measured in nanoseconds since the clock was created, as an unsigned 64-bit
+ *   integer (over 500 years of range).
+ * - Virtual time starts at 0, and only advances while runUntil() is executing.
+ * - Events are identified by a handle, which is returned when the event is scheduled.
+ * - The maximum number of pending events is specified when the clock is instantiated.
+ * - All functions are called from the thread that runs the scheduler.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Scheduling fails if the event queue is full. Cancelled events continue to occupy capacity
+ *   until they reach the top of the heap, so scheduling can fail even though fewer events than
+ *   the capacity are pending. See the file documentation.
+ * - Events scheduled for a time in the past run at the current time, after any events already
+ *   scheduled for the current time.
+ * - Cancelling an event that has already run or been cancelled has no effect, even if its slot
+ *   has since been reused by another event. Handles include a generation count for this purpose.
+ *
+ * ## Implementation Notes
+ *
+ * - See the file documentation for the reference event queue design.
+ */
+typedef struct
+{
+	/** Get the current virtual time
+	 *
+	 * @returns The current virtual time, in nanoseconds.
+	 */
+	uint64_t (*now)(void);
+
+	/** Schedule an event
+	 *
+	 * @pre callback is not NULL.
+	 * @pre handle is not NULL.
+	 * @post If the event was scheduled, the data pointed to by handle identifies the event.
+	 * @post If the event could not be scheduled, the data pointed to by handle will remain
+	 *  unchanged.
+	 *
+	 * @param[in] time The virtual time at which the event should run, in nanoseconds.
+	 * @param[in] callback The function to invoke.
+	 * @param[in] context A pointer passed to the callback. May be NULL.
+	 * @param[inout] handle Pointer which will be used to store the handle of the event.
+	 *
+	 * @returns True if the event was scheduled, false if the event queue is full.
+	 */
+	bool (*schedule)(uint64_t time, VirtualClockEventCb callback, void* context,
+					 uint32_t* const handle);
+
+	/** Cancel a scheduled event
+	 *
+	 * @post The event will not run.
+	 *
+	 * @param[in] handle The handle of the event to cancel.
+	 */
+	void (*cancel)(uint32_t handle);
+
+	/** Run events until the specified time
+	 *
+	 * Runs all events scheduled at or before the specified time, in order, advancing virtual time
+	 * to each event's scheduled time before invoking its callback. When no events remain at or
+	 * before the specified time, virtual time is advanced to the specified time.
+	 *
+	 * @param[in] time The virtual time to run until, in nanoseconds.
+	 *
+	 * @returns The number of events that were run.
+	 */
+	uint64_t (*runUntil)(uint64_t time);
+} VirtualClock;
+
+#endif // SIMULATION_VIRTUAL_CLOCK_H_
@@ -0,0 +1,305 @@
+/*
+*  This file is used to measure the memory footprint of each interface variant.
+*
+*  Each variant is selected with a FOOTPRINT_<VARIANT> define, and provides a minimal
+*  implementation: stub functions, the interface instance, and (for variants with callback
+*  support) fixed-size callback lists with registration and dispatch, built with
+*  interface_patterns/observer.h. The size of each list is controlled with
+*  FOOTPRINT_MAX_CALLBACKS.
+*
+*  See the "footprint" target in the Makefile.
+*/
+#include <interface_patterns/observer.h>
+#include <stddef.h>
+#include <virtual_devices/barometric_altimeter.h>
+#include <virtual_devices/barometric_pressure_sensor.h>
+#include <virtual_devices/barometric_sensor.h>
+#include <virtual_devices/humidity_sensor.h>
+#include <virtual_devices/temperature_sensor.h>
+
+#if !defined(FOOTPRINT_BAROMETRIC_SENSOR) && !defined(FOOTPRINT_BAROMETRIC_SENSOR_WITHCB) && \
+	!defined(FOOTPRINT_BAROMETRIC_SENSOR_ASYNCWITHCB) && \
+	!defined(FOOTPRINT_BAROMETRIC_ALTIMETER) && !defined(FOOTPRINT_BAROMETRIC_PRESSURE_SENSOR) && \
+	!defined(FOOTPRINT_TEMPERATURE_SENSOR) && !defined(FOOTPRINT_TEMPERATURE_SENSOR_WITHCB) && \
+	!defined(FOOTPRINT_HUMIDITY_SENSOR) && !defined(FOOTPRINT_HUMIDITY_SENSOR_WITHCB)
+#error "Select an interface variant with a FOOTPRINT_<VARIANT> define"
+#endif
+
+#ifndef FOOTPRINT_MAX_CALLBACKS
+#define FOOTPRINT_MAX_CALLBACKS 4
+#endif
+
+/// Stands in for the device: set when the device reports an error.
+static volatile bool device_fault;
+
+// Overflow is ignored rather than asserted, so that the measurement does not include assert().
+#define FOOTPRINT_CALLBACK_LIST(type, list) \
+	OBSERVER_LIST_DECLARE(list##_List, type, FOOTPRINT_MAX_CALLBACKS) \
+	static list##_List list; \
+	static void list##_register(const type callback) \
+	{ \
+		(void)list##_List_subscribe(&list, callback); \
+	} \
+	static void list##_unregister(const type callback) \
+	{ \
+		list##_List_unsubscribe(&list, callback); \
+	}
+
+#define FOOTPRINT_DISPATCH(list, args) OBSERVER_LIST_DISPATCH(list##_List, &list, args);
+
+#pragma mark - Barometric Sensor -
+
+#if defined(FOOTPRINT_BAROMETRIC_SENSOR) || defined(FOOTPRINT_BAROMETRIC_SENSOR_WITHCB) || \
+	defined(FOOTPRINT_BAROMETRIC_SENSOR_ASYNCWITHCB) || defined(FOOTPRINT_BAROMETRIC_ALTIMETER) || \
+	defined(FOOTPRINT_BAROMETRIC_PRESSURE_SENSOR)
+static volatile uint32_t raw_pressure;
+#endif
+
+#if defined(FOOTPRINT_BAROMETRIC_SENSOR) || defined(FOOTPRINT_BAROMETRIC_SENSOR_WITHCB) || \
+	defined(FOOTPRINT_BAROMETRIC_SENSOR_ASYNCWITHCB) || defined(FOOTPRINT_BAROMETRIC_ALTIMETER)
+static uint32_t sea_level_pressure = 1037568; // 1013.25 hPa in UQ22.10
+
+// Placeholder conversion: the cost of a real altitude calculation depends on the driver.
+static int32_t computeAltitude(uint32_t pressure)
+{
+	return (int32_t)(sea_level_pressure - pressure) * 8;
+}
+
+static void setSeaLevelPressure(uint32_t slp)
+{
+	sea_level_pressure = slp;
+}
+#endif
+
+#if defined(FOOTPRINT_BAROMETRIC_SENSOR_WITHCB) || defined(FOOTPRINT_BAROMETRIC_SENSOR_ASYNCWITHCB)
+FOOTPRINT_CALLBACK_LIST(NewBarometricSampleCb, sample_cbs)
+FOOTPRINT_CALLBACK_LIST(BarometricErrorCb, error_cbs)
+
+static bool sample(uint32_t* const pressure, int32_t* const altitude)
+{
+	if(device_fault)
+	{
+		FOOTPRINT_DISPATCH(error_cbs, ())
+		return false;
+	}
+
+	uint32_t p = raw_pressure;
+	int32_t a = computeAltitude(p);
+	if(pressure)
+	{
+		*pressure = p;
+	}
+	if(altitude)
+	{
+		*altitude = a;
+	}
+	FOOTPRINT_DISPATCH(sample_cbs, (p, a))
+	return true;
+}
+#endif
+
+#if defined(FOOTPRINT_BAROMETRIC_SENSOR)
+static bool readPressure(uint32_t* const pressure)
+{
+	if(device_fault)
+	{
+		return false;
+	}
+	*pressure = raw_pressure;
+	return true;
+}
+
+static bool readAltitude(int32_t* const altitude)
+{
+	if(device_fault)
+	{
+		return false;
+	}
+	*altitude = computeAltitude(raw_pressure);
+	return true;
+}
+
+const BarometricSensor footprint_instance = {
+	readPressure,
+	readAltitude,
+	setSeaLevelPressure,
+};
+#elif defined(FOOTPRINT_BAROMETRIC_SENSOR_WITHCB)
+static bool readPressure(uint32_t* const pressure)
+{
+	return sample(pressure, NULL);
+}
+
+static bool readAltitude(int32_t* const altitude)
+{
+	return sample(NULL, altitude);
+}
+
+const BarometricSensor_withCb footprint_instance = {
+	readPressure,
+	readAltitude,
+	setSeaLevelPressure,
+	sample_cbs_register,
+	sample_cbs_unregister,
+	error_cbs_register,
+	error_cbs_unregister,
+};
+#elif defined(FOOTPRINT_BAROMETRIC_SENSOR_ASYNCWITHCB)
+// The request queue is represented by a single pending flag, serviced by processRequests().
+static volatile bool request_pending;
+
+static bool readSample(void)
+{
+	if(request_pending)
+	{
+		return false;
+	}
+	request_pending = true;
+	return true;
+}
+
+void processRequests(void)
+{
+	if(request_pending)
+	{
+		request_pending = false;
+		(void)sample(NULL, NULL);
+	}
+}
+
+const BarometricSensor_asyncWithCb footprint_instance = {
+	readSample,
+	setSeaLevelPressure,
+	sample_cbs_register,
+	sample_cbs_unregister,
+	error_cbs_register,
+	error_cbs_unregister,
+};
+#elif defined(FOOTPRINT_BAROMETRIC_ALTIMETER)
+static bool readAltitude(int32_t* const altitude)
+{
+	if(device_fault)
+	{
+		return false;
+	}
+	*altitude = computeAltitude(raw_pressure);
+	return true;
+}
+
+const BarometricAltimeter footprint_instance = {
+	readAltitude,
+	setSeaLevelPressure,
+};
+#elif defined(FOOTPRINT_BAROMETRIC_PRESSURE_SENSOR)
+static bool readPressure(uint32_t* const pressure)
+{
+	if(device_fault)
+	{
+		return false;
+	}
+	*pressure = raw_pressure;
+	return true;
+}
+
+const BarometricPressureSensor footprint_instance = {
+	readPressure,
+};
+#endif
+
+#pragma mark - Temperature Sensor -
+
+#if defined(FOOTPRINT_TEMPERATURE_SENSOR)
+static volatile int16_t raw_temperature;
+
+static bool readTemperature(int16_t* const temperature)
+{
+	if(device_fault)
+	{
+		return false;
+	}
+	*temperature = raw_temperature;
+	return true;
+}
+
+const TemperatureSensor footprint_instance = {
+	readTemperature,
+};
+#elif defined(FOOTPRINT_TEMPERATURE_SENSOR_WITHCB)
+static volatile int16_t raw_temperature;
+FOOTPRINT_CALLBACK_LIST(NewTemperatureSampleCb, sample_cbs)
+FOOTPRINT_CALLBACK_LIST(TemperatureErrorCb, error_cbs)
+
+static bool readTemperature(int16_t* const temperature)
+{
+	if(device_fault)
+	{
+		FOOTPRINT_DISPATCH(error_cbs, ())
+		return false;
+	}
+
+	int16_t t = raw_temperature;
+	if(temperature)
+	{
+		*temperature = t;
+	}
+	FOOTPRINT_DISPATCH(sample_cbs, (t))
+	return true;
+}
+
+const TemperatureSensor_withCb footprint_instance = {
+	readTemperature,
+	sample_cbs_register,
+	sample_cbs_unregister,
+	error_cbs_register,
+	error_cbs_unregister,
+};
+#endif
+
+#pragma mark - Humidity Sensor -
+
+#if defined(FOOTPRINT_HUMIDITY_SENSOR)
+static volatile uint8_t raw_humidity;
+
+static bool getHumidity(uint8_t* const humidity)
+{
+	if(device_fault)
+	{
+		return false;
+	}
+	*humidity = raw_humidity;
+	return true;
+}
+
+const HumiditySensor footprint_instance = {
+	getHumidity,
+};
+#elif defined(FOOTPRINT_HUMIDITY_SENSOR_WITHCB)
+static volatile uint8_t raw_humidity;
+FOOTPRINT_CALLBACK_LIST(NewHumiditySampleCb, sample_cbs)
+FOOTPRINT_CALLBACK_LIST(HumidityErrorCb, error_cbs)
+
+static bool getHumidity(uint8_t* const humidity)
+{
+	if(device_fault)
+	{
+		FOOTPRINT_DISPATCH(error_cbs, ())
+		return false;
+	}
+
+	uint8_t h = raw_humidity;
+	if(humidity)
+	{
+		*humidity = h;
+	}
+	FOOTPRINT_DISPATCH(sample_cbs, (h))
+	return true;
+}
+
+const HumiditySensor_withCb footprint_instance = {
+	getHumidity,
+	sample_cbs_register,
+	sample_cbs_unregister,
+	error_cbs_register,
+	error_cbs_unregister,
+};
+#endif
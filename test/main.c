@@ -6,8 +6,66 @@
 #include <virtual_devices/barometric_pressure_sensor.h>
 #include <virtual_devices/humidity_sensor.h>
 #include <virtual_devices/temperature_sensor.h>
+#include <virtual_devices/altitude_estimator.h>
+#include <virtual_devices/sensor_filter.h>
+#include <virtual_devices/outlier_filter.h>
+#include <virtual_devices/sensor_voter.h>
+#include <virtual_devices/sensor_calibration.h>
+#include <virtual_devices/anomaly_detector.h>
+#include <virtual_devices/sensor_alarm.h>
+#include <virtual_devices/temperature_fusion.h>
+#include <virtual_devices/adaptive_sampler.h>
+#include <virtual_devices/variometer.h>
+
+#include <instrumentation/trace.h>
+#include <instrumentation/metrics.h>
+#include <instrumentation/sensor_health.h>
+#include <instrumentation/trace_export.h>
+
+#include <simulation/barometric_simulator.h>
+#include <simulation/environment_simulator.h>
+#include <simulation/fault_injector.h>
+#include <simulation/fleet_harness.h>
+#include <simulation/virtual_clock.h>
+
+#include <os/mutex.h>
+#include <os/pool.h>
+#include <os/queue.h>
+#include <os/semaphore.h>
+#include <os/timer.h>
+
+#include <interface_patterns/observer.h>
+
+// Macro-generated and template components are only checked when expanded.
+OBSERVER_LIST_DECLARE(BarometricSampleObservers, NewBarometricSampleCb, 4)
+
+static BarometricSampleObservers barometric_sample_observers;
+
+#ifdef __cplusplus
+static ObserverList<NewBarometricSampleCb, 4> barometric_sample_observer_list;
+#endif
+
+static void onBarometricSample(uint32_t pressure, int32_t altitude)
+{
+	(void)pressure;
+	(void)altitude;
+}
 
 int main(void)
 {
+	uint32_t pressure = 0;
+	int32_t altitude = 0;
+
+	(void)BarometricSampleObservers_subscribe(&barometric_sample_observers, onBarometricSample);
+	OBSERVER_LIST_DISPATCH(BarometricSampleObservers, &barometric_sample_observers,
+						   (pressure, altitude));
+	BarometricSampleObservers_unsubscribe(&barometric_sample_observers, onBarometricSample);
+
+#ifdef __cplusplus
+	(void)barometric_sample_observer_list.subscribe(onBarometricSample);
+	barometric_sample_observer_list.dispatch(pressure, altitude);
+	barometric_sample_observer_list.unsubscribe(onBarometricSample);
+#endif
+
 	return 0;
 }
@@ -0,0 +1,192 @@
+/*
+*  This file checks the behavior of interface_patterns/observer.h.
+*
+*  It is compiled and run as C and as C++ (which also exercises ObserverList).
+*  See the "test" target in the Makefile.
+*/
+#include <interface_patterns/observer.h>
+#include <stdio.h>
+
+typedef void (*TestCb)(int value);
+
+static unsigned failures;
+static int calls_a, calls_b, calls_c, calls_d;
+
+#define CHECK(condition) \
+	do \
+	{ \
+		if(!(condition)) \
+		{ \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			failures++; \
+		} \
+	} while(0)
+
+static void resetCalls(void)
+{
+	calls_a = 0;
+	calls_b = 0;
+	calls_c = 0;
+	calls_d = 0;
+}
+
+static void cbA(int value)
+{
+	calls_a += value;
+}
+
+static void cbB(int value)
+{
+	calls_b += value;
+}
+
+static void cbC(int value)
+{
+	calls_c += value;
+}
+
+static void cbD(int value)
+{
+	calls_d += value;
+}
+
+#pragma mark - C Interface -
+
+OBSERVER_LIST_DECLARE(TestList, TestCb, 3)
+
+static TestList list;
+
+// Unsubscribes itself, and subscribes cbD, while the list is being dispatched.
+static void cbModifying(int value)
+{
+	calls_a += value;
+	TestList_unsubscribe(&list, cbModifying);
+	(void)TestList_subscribe(&list, cbD);
+}
+
+static void dispatch(int value)
+{
+	OBSERVER_LIST_DISPATCH(TestList, &list, (value));
+}
+
+static void testDuplicateSubscription(void)
+{
+	resetCalls();
+	CHECK(TestList_subscribe(&list, cbA));
+	CHECK(TestList_subscribe(&list, cbA));
+	CHECK(list.count == 1);
+	dispatch(1);
+	CHECK(calls_a == 1);
+	TestList_unsubscribe(&list, cbA);
+	CHECK(list.count == 0);
+}
+
+static void testCapacity(void)
+{
+	resetCalls();
+	CHECK(TestList_subscribe(&list, cbA));
+	CHECK(TestList_subscribe(&list, cbB));
+	CHECK(TestList_subscribe(&list, cbC));
+	CHECK(!TestList_subscribe(&list, cbD));
+	CHECK(list.count == 3);
+	dispatch(1);
+	CHECK(calls_a == 1 && calls_b == 1 && calls_c == 1 && calls_d == 0);
+}
+
+static void testHoleReuse(void)
+{
+	resetCalls();
+	// Continues from testCapacity(): [A, B, C]
+	TestList_unsubscribe(&list, cbB);
+	CHECK(list.count == 3);
+	CHECK(list.subscribers[1] == NULL);
+	CHECK(TestList_subscribe(&list, cbD));
+	CHECK(list.subscribers[1] == cbD);
+	CHECK(list.count == 3);
+	dispatch(1);
+	CHECK(calls_a == 1 && calls_b == 0 && calls_c == 1 && calls_d == 1);
+}
+
+static void testTrailingTrim(void)
+{
+	// Continues from testHoleReuse(): [A, D, C]
+	TestList_unsubscribe(&list, cbD);
+	CHECK(list.count == 3);
+	TestList_unsubscribe(&list, cbC);
+	CHECK(list.count == 1);
+	TestList_unsubscribe(&list, cbB); // Not present
+	CHECK(list.count == 1);
+	TestList_unsubscribe(&list, cbA);
+	CHECK(list.count == 0);
+	resetCalls();
+	dispatch(1);
+	CHECK(calls_a == 0 && calls_b == 0 && calls_c == 0 && calls_d == 0);
+}
+
+static void testModificationDuringDispatch(void)
+{
+	resetCalls();
+	CHECK(TestList_subscribe(&list, cbModifying));
+	CHECK(TestList_subscribe(&list, cbB));
+	dispatch(1);
+	// cbD filled the hole left by cbModifying, which the dispatch had already passed.
+	CHECK(calls_a == 1 && calls_b == 1 && calls_d == 0);
+	dispatch(1);
+	CHECK(calls_a == 1 && calls_b == 2 && calls_d == 1);
+	TestList_unsubscribe(&list, cbB);
+	TestList_unsubscribe(&list, cbD);
+	CHECK(list.count == 0);
+}
+
+#pragma mark - C++ Interface -
+
+#ifdef __cplusplus
+static void testObserverList(void)
+{
+	ObserverList<TestCb, 3> observers;
+
+	resetCalls();
+	CHECK(observers.subscribe(cbA));
+	CHECK(observers.subscribe(cbA));
+	CHECK(observers.subscribe(cbB));
+	CHECK(observers.subscribe(cbC));
+	CHECK(!observers.subscribe(cbD));
+	observers.dispatch(1);
+	CHECK(calls_a == 1 && calls_b == 1 && calls_c == 1 && calls_d == 0);
+
+	observers.unsubscribe(cbB);
+	CHECK(observers.subscribe(cbD));
+	CHECK(!observers.subscribe(cbB));
+	resetCalls();
+	observers.dispatch(2);
+	CHECK(calls_a == 2 && calls_b == 0 && calls_c == 2 && calls_d == 2);
+
+	observers.unsubscribe(cbC);
+	observers.unsubscribe(cbD);
+	CHECK(observers.subscribe(cbB));
+	CHECK(observers.subscribe(cbC));
+	resetCalls();
+	observers.dispatch(1);
+	CHECK(calls_a == 1 && calls_b == 1 && calls_c == 1 && calls_d == 0);
+}
+#endif
+
+int main(void)
+{
+	testDuplicateSubscription();
+	testCapacity();
+	testHoleReuse();
+	testTrailingTrim();
+	testModificationDuringDispatch();
+#ifdef __cplusplus
+	testObserverList();
+#endif
+
+	if(failures)
+	{
+		printf("observer: %u check(s) failed\n", failures);
+		return 1;
+	}
+
+	return 0;
+}
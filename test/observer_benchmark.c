@@ -0,0 +1,136 @@
+/*
+*  This file compares the cost of OBSERVER_LIST_DISPATCH() against a hand-written loop over a
+*  plain callback array, which is how callback lists were implemented before observer.h.
+*
+*  Both lists hold the same subscribers in the same slots. The subscribers are defined in this
+*  file, but their addresses are stored in the lists, so both loops make indirect calls.
+*  Each configuration is timed several times, and the fastest run is reported.
+*
+*  See the "benchmark" target in the Makefile.
+*/
+#include <interface_patterns/observer.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define BENCHMARK_CAPACITY 16
+
+#ifndef BENCHMARK_ITERATIONS
+#define BENCHMARK_ITERATIONS 2000000
+#endif
+
+#define BENCHMARK_RUNS 5
+
+typedef void (*BenchmarkCb)(uint32_t value);
+
+static volatile uint32_t sink;
+
+#define BENCHMARK_CB(n) \
+	static void cb##n(uint32_t value) \
+	{ \
+		sink += value ^ n; \
+	}
+
+BENCHMARK_CB(0)
+BENCHMARK_CB(1)
+BENCHMARK_CB(2)
+BENCHMARK_CB(3)
+BENCHMARK_CB(4)
+BENCHMARK_CB(5)
+BENCHMARK_CB(6)
+BENCHMARK_CB(7)
+BENCHMARK_CB(8)
+BENCHMARK_CB(9)
+BENCHMARK_CB(10)
+BENCHMARK_CB(11)
+BENCHMARK_CB(12)
+BENCHMARK_CB(13)
+BENCHMARK_CB(14)
+BENCHMARK_CB(15)
+
+static const BenchmarkCb subscribers[BENCHMARK_CAPACITY] = {
+	cb0, cb1, cb2, cb3, cb4, cb5, cb6, cb7, cb8, cb9, cb10, cb11, cb12, cb13, cb14, cb15,
+};
+
+OBSERVER_LIST_DECLARE(BenchmarkList, BenchmarkCb, BENCHMARK_CAPACITY)
+
+static BenchmarkList observer_list;
+static BenchmarkCb hand_written_list[BENCHMARK_CAPACITY];
+
+static uint64_t nanoseconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void fill(size_t count)
+{
+	for(size_t i = 0; i < BENCHMARK_CAPACITY; i++)
+	{
+		BenchmarkList_unsubscribe(&observer_list, subscribers[i]);
+		hand_written_list[i] = NULL;
+	}
+
+	for(size_t i = 0; i < count; i++)
+	{
+		(void)BenchmarkList_subscribe(&observer_list, subscribers[i]);
+		hand_written_list[i] = subscribers[i];
+	}
+}
+
+static uint64_t timeObserverList(void)
+{
+	uint64_t best = UINT64_MAX;
+	for(int run = 0; run < BENCHMARK_RUNS; run++)
+	{
+		uint64_t start = nanoseconds();
+		for(uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++)
+		{
+			OBSERVER_LIST_DISPATCH(BenchmarkList, &observer_list, (i));
+		}
+		uint64_t elapsed = nanoseconds() - start;
+		best = elapsed < best ? elapsed : best;
+	}
+	return best;
+}
+
+static uint64_t timeHandWritten(void)
+{
+	uint64_t best = UINT64_MAX;
+	for(int run = 0; run < BENCHMARK_RUNS; run++)
+	{
+		uint64_t start = nanoseconds();
+		for(uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++)
+		{
+			for(size_t j = 0; j < BENCHMARK_CAPACITY; j++)
+			{
+				if(hand_written_list[j] != NULL)
+				{
+					hand_written_list[j](i);
+				}
+			}
+		}
+		uint64_t elapsed = nanoseconds() - start;
+		best = elapsed < best ? elapsed : best;
+	}
+	return best;
+}
+
+int main(void)
+{
+	static const size_t counts[] = {1, 4, BENCHMARK_CAPACITY};
+
+	printf("capacity %d, %d dispatches per run\n", BENCHMARK_CAPACITY, BENCHMARK_ITERATIONS);
+	printf("%-12s %16s %16s %8s\n", "subscribers", "observer ns/op", "hand ns/op", "ratio");
+
+	for(size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+	{
+		fill(counts[i]);
+		double observer = (double)timeObserverList() / BENCHMARK_ITERATIONS;
+		double hand = (double)timeHandWritten() / BENCHMARK_ITERATIONS;
+		printf("%-12zu %16.2f %16.2f %8.2f\n", counts[i], observer, hand, observer / hand);
+	}
+
+	return 0;
+}
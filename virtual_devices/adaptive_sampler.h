@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef VIRTUAL_ADAPTIVE_SAMPLER_H_
+#define VIRTUAL_ADAPTIVE_SAMPLER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file adaptive_sampler.h
+ * Example interface for an adaptive sampling-rate controller.
+ *
+ * An adaptive sampler periodically requests samples from a sensor, and adjusts the request rate
+ * based on how much the signal is changing. When the signal is flat, samples are requested
+ * less often, saving bus bandwidth and CPU time. When the signal changes quickly, samples are
+ * requested more often.
+ *
+ * The sampler drives one of the following sensor interfaces, supplied by the system when the
+ * sampler is instantiated:
+ *
+ * - BarometricSensor_asyncWithCb: each request calls readSample()
+ * - TemperatureSensor_withCb or HumiditySensor_withCb: these do not currently have asynchronous
+ *   variants, so each request calls the read function with a NULL parameter, which triggers a
+ *   sample that is delivered to registered callbacks
+ *
+ * The sampler observes the resulting samples through the sensor's "new sample" callback.
+ * Consumers keep subscribing to the sensor directly; the sampler only controls *when* samples
+ * are requested.
+ *
+ * ## Rate Control Model
+ *
+ * The reference implementation tracks an exponentially weighted estimate of the signal's
+ * activity: the absolute first difference of the samples, scaled by the current sample period
+ * (so it approximates the derivative), plus the exponentially weighted variance
+ * (see anomaly_detector.h). Both are updated with shifts in the sensor's fixed-point format.
+ *
+ * - If the activity is above a "high" threshold, the sample period is halved.
+ * - If the activity is below a "low" threshold, the sample period is increased by a fixed step.
+ * - The period is always clamped to the configured bounds.
+ *
+ * This multiplicative-decrease, additive-increase scheme reacts quickly to sudden changes and
+ * backs off slowly when the signal settles.
+ *
+ * Errors reported by the sensor carry no information about the signal, so they do not update the
+ * activity estimate. A single error holds the current period. Each further consecutive error
+ * doubles the period, up to the maximum, so that a failing sensor is not polled at a high rate
+ * (and a shared bus is not flooded with requests that will also fail). The next valid sample
+ * resets the error count, and normal rate control resumes from the backed-off period.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Expose the activity thresholds so they can be tuned at runtime
+ * - Report other statistics, such as the number of requests rejected because the queue was full
+ * - Coordinate the rates of several sensors that share a bus
+ */
+
+/** Virtual Adaptive Sampler Interface
+ *
+ * A standard interface for controlling an adaptive sampling-rate controller.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The sampler drives exactly one underlying sensor, which is supplied by the system when the
+ *   sampler is instantiated.
+ * - The sampler has its own timing source (e.g., a periodic timer), which is supplied when the
+ *   sampler is instantiated.
+ * - Sample periods are specified in microseconds.
+ * - The bus time consumed by a single sample request is specified in microseconds when the
+ *   sampler is instantiated. It is used to compute the bus time saved.
+ * - The sampler starts at the minimum period (the maximum rate).
+ *
+ * ## Undesired event assumptions
+ *
+ * - If a request cannot be made (e.g., readSample() reports that the queue is full), the sampler
+ *   will try again at the next period. The request is not retried immediately.
+ * - If the underlying sensor reports an error, the sampler holds its current period. If errors
+ *   continue, it backs off toward the maximum period, as described in the file documentation.
+ *
+ * ## Implementation Notes
+ *
+ * - The rate control update is performed in the sensor's "new sample" callback, so it must be
+ *   kept small and use only integer operations.
+ * - The saved bus time is updated from the sampling context and read by system code. Use an
+ *   atomic 64-bit counter (or a lock) on platforms where 64-bit loads are not atomic.
+ */
+typedef struct
+{
+	/** Set the bounds for the sample period
+	 *
+	 * If the current period lies outside of the new bounds, it is clamped immediately.
+	 *
+	 * @post If the bounds are valid, the sample period will remain within them.
+	 * @post If the bounds are invalid, the configuration is unchanged.
+	 *
+	 * @param[in] min_period_us The minimum sample period (maximum rate), in microseconds.
+	 * @param[in] max_period_us The maximum sample period (minimum rate), in microseconds.
+	 *
+	 * @returns True if the bounds were applied, false if they are invalid
+	 *  (e.g., min_period_us is 0 or greater than max_period_us).
+	 */
+	bool (*setPeriodBounds)(uint32_t min_period_us, uint32_t max_period_us);
+
+	/** Get the current sample period
+	 *
+	 * @returns The current sample period, in microseconds.
+	 */
+	uint32_t (*getSamplePeriod)(void);
+
+	/** Get the bus time saved by adaptive sampling
+	 *
+	 * The saved time is the difference between the bus time that would have been used by sampling
+	 * at the minimum period, and the bus time actually used, since the sampler was started.
+	 *
+	 * @returns The total bus time saved, in microseconds.
+	 */
+	uint64_t (*getBusTimeSaved)(void);
+} AdaptiveSampler;
+
+#endif // VIRTUAL_ADAPTIVE_SAMPLER_H_
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef VIRTUAL_ALTITUDE_ESTIMATOR_H_
+#define VIRTUAL_ALTITUDE_ESTIMATOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file altitude_estimator.h
+ * Example altitude and vertical speed estimator interface.
+ *
+ * This header defines a derived virtual device that estimates altitude and vertical speed from
+ * the samples produced by a BarometricAltimeter (see barometric_altimeter.h). The first functions
+ * in the interface mirror BarometricAltimeter, so an estimator can be used anywhere application
+ * code only needs a (smoother) altitude reading.
+ *
+ * ## Estimation Model
+ *
+ * The reference implementation is a two-state Kalman filter with state [altitude, climb rate]
+ * and a constant-velocity process model. Only altitude is measured. With a fixed sample period,
+ * the error covariance converges to a steady state, so the gains can be computed once when the
+ * estimator is created and each update reduces to a handful of fixed-point multiply-adds:
+ *
+ *     altitude += climb_rate * dt;
+ *     error = measured_altitude - altitude;
+ *     altitude += K_altitude * error;
+ *     climb_rate += K_rate * error;
+ *
+ * Gains should be stored in Q16 format and products accumulated in 64-bit integers before
+ * shifting back to Q21.10. No floating point is needed on the sample path.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Change the format of the estimates (e.g., to Q16.16 across all values in your program)
+ * - Add vertical acceleration as a third state, or accept accelerometer samples as a control input
+ * - Expose noise parameters so the filter can be re-tuned at runtime (e.g., when the underlying
+ *   sensor's oversampling mode changes)
+ * - Report both estimates from a single function call, or via a callback (see
+ *   barometric_sensor.h for callback examples)
+ */
+
+/** Virtual Altitude Estimator Interface
+ *
+ * A standard interface for a derived device which estimates altitude and vertical speed from an
+ * underlying barometric altimeter.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The estimator is driven by exactly one underlying BarometricAltimeter, which is supplied by
+ *   the system when the estimator is instantiated.
+ * - The estimator samples the underlying altimeter at a fixed rate, which is specified when the
+ *   estimator is instantiated.
+ * - The device reports estimated altitude in meters
+ * 	- Altitude will be formatted as a 32-bit fixed-point integer with format Q21.10,
+ *    giving a resolution of 0.001 m.
+ * 	- Altitude will be corrected for Sea Level Pressure. If no value for SLP has been supplied,
+ *    calculations will assume 1013.25 hPa.
+ * - The device reports estimated vertical speed in meters per second (m/s)
+ * 	- Vertical speed is positive when climbing and negative when descending.
+ * 	- Vertical speed will be formatted as a 32-bit fixed-point integer with format Q21.10,
+ *    giving a resolution of 0.001 m/s.
+ * - Both estimates are produced from the same filter update, so they are always consistent with
+ *   each other.
+ * - The device will indicate whether the current estimate is valid or invalid
+ * 	- Estimates are invalid until the filter has been initialized with a valid altitude sample.
+ *
+ * ## Undesired event assumptions
+ *
+ * - If the underlying altimeter produces an invalid sample, the estimator will skip the
+ *   measurement update and continue to predict from its current state.
+ * - If the underlying altimeter produces consecutive invalid samples beyond an
+ *   implementation-defined limit, the estimates will be reported as invalid until reset() is
+ *   called or a new valid sample is received.
+ *
+ * ## Implementation Notes
+ *
+ * - Steady-state gains should be pre-computed when the estimator is created. The per-sample update
+ *   should use only integer operations.
+ * - This interface, at its core, appears to be blocking. However, you can still implement this
+ *   interface in a non-blocking way. For example, you could always return the most recent
+ *   estimate, while there is another thread (or a timer) that samples the underlying altimeter
+ *   and updates the filter at the configured rate.
+ */
+typedef struct
+{
+	/** Get the current estimated altitude, corrected for SLP
+	 *
+	 * If no value for SLP has been supplied, calculations will assume 1013.25 hPa.
+	 *
+	 * @pre The estimator has been properly initialized by the system.
+	 * @pre The altitude parameter is not NULL.
+	 * @post If the estimate is valid, the data pointed to by the altitude parameter
+	 *       will be updated with the latest estimate.
+	 * @post If the estimate is invalid, the data pointed to by the altitude parameter
+	 *       will remain unchanged.
+	 *
+	 * @param[inout] altitude Estimated altitude in meters (m), corrected for sea level pressure.
+	 *	Altitude is specified as a signed 32-bit fixed-point number in format Q21.10.
+	 *
+	 * @returns True if the estimate is valid, false if invalid.
+	 */
+	bool (*readAltitude)(int32_t* const altitude);
+
+	/** Set the sea level pressure
+	 *
+	 * The value is forwarded to the underlying altimeter. The estimator will be reset, since the
+	 * step in reported altitude would otherwise be interpreted as vertical movement.
+	 *
+	 * @param[in] slp The current sea level pressure in hPa.
+	 * 	slp should be specified as an unsigned 32-bit fixed-point number in format UQ22.10.
+	 */
+	void (*setSeaLevelPressure)(const uint32_t slp);
+
+	/** Get the current estimated vertical speed
+	 *
+	 * @pre The estimator has been properly initialized by the system.
+	 * @pre The speed parameter is not NULL.
+	 * @post If the estimate is valid, the data pointed to by the speed parameter
+	 *       will be updated with the latest estimate.
+	 * @post If the estimate is invalid, the data pointed to by the speed parameter
+	 *       will remain unchanged.
+	 *
+	 * @param[inout] speed Estimated vertical speed in meters per second (m/s).
+	 *  Positive values indicate a climb. Vertical speed is specified as a signed 32-bit
+	 *  fixed-point number in format Q21.10.
+	 *
+	 * @returns True if the estimate is valid, false if invalid.
+	 */
+	bool (*readVerticalSpeed)(int32_t* const speed);
+
+	/** Reset the estimator
+	 *
+	 * Discard the current filter state. The next valid altitude sample will be used to initialize
+	 * the altitude estimate, and the vertical speed estimate will be initialized to 0.
+	 *
+	 * @post Estimates are invalid until the next valid altitude sample is received.
+	 */
+	void (*reset)(void);
+} AltitudeEstimator;
+
+#endif // VIRTUAL_ALTITUDE_ESTIMATOR_H_
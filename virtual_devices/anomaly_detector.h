@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef VIRTUAL_ANOMALY_DETECTOR_H_
+#define VIRTUAL_ANOMALY_DETECTOR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file anomaly_detector.h
+ * Example interface for a streaming anomaly detector attached to a sensor.
+ *
+ * An anomaly detector wraps a sensor with callback support (e.g., BarometricSensor_withCb,
+ * TemperatureSensor_withCb, or HumiditySensor_withCb) and presents the same interface.
+ * The detector registers a "new sample" callback with the underlying sensor and inspects each
+ * sample before forwarding it, unchanged, to its own registered callbacks.
+ *
+ * When an anomaly is detected, the detector invokes its registered *error* callbacks
+ * (e.g., BarometricErrorCb). This means existing error handling code will respond to anomalies
+ * without modification. Because error callbacks have no parameters, system code that wants to
+ * know which anomaly occurred can query the detector with getAnomalies().
+ *
+ * ## Detection Model
+ *
+ * No sample history is buffered. Each check uses constant memory and O(1) integer work per
+ * sample. The design target is 100k samples/s or more on a single core:
+ *
+ * - **Stuck-at**: count consecutive samples that are bit-identical to the previous sample.
+ *   The anomaly is raised when the count exceeds a limit.
+ * - **Excessive noise**: track the running variance of the first difference of the sample
+ *   stream. Welford's algorithm is numerically poor in narrow integer types, so the reference
+ *   implementation uses an exponentially weighted mean and variance updated with shifts:
+ *
+ *       delta = x - mean;
+ *       mean += delta >> k;
+ *       var  += ((delta * delta) >> k) - (var >> k);
+ *
+ *   Using the first difference means that slow, legitimate changes do not register as noise.
+ * - **Rate of change**: a two-sided CUSUM on the first difference. Small excursions decay away,
+ *   and a sustained rate beyond the allowed drift accumulates until it crosses a threshold:
+ *
+ *       pos = max(0, pos + d - drift);
+ *       neg = max(0, neg - d - drift);
+ *
+ * Sample values are used in their native fixed-point format. Squares are accumulated in 64 bits.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Use a dedicated anomaly callback that receives the anomaly flags, rather than re-using the
+ *   error callback path
+ * - Drop samples while an anomaly is active instead of forwarding them
+ * - Expose the detection thresholds so they can be tuned at runtime
+ * - Use exact Welford statistics over all samples (with 64-bit state) instead of exponentially
+ *   weighted statistics
+ */
+
+/** Anomaly flags reported by an AnomalyDetector
+ *
+ * The flags are combined into a bitmask.
+ */
+typedef enum
+{
+	/// The sensor has produced the same value for longer than the configured limit.
+	ANOMALY_STUCK = (1 << 0),
+	/// The sample-to-sample variance exceeds the configured limit.
+	ANOMALY_NOISE = (1 << 1),
+	/// The value is changing faster than the configured rate.
+	ANOMALY_RATE = (1 << 2),
+} AnomalyFlags;
+
+/** Virtual Anomaly Detector Interface
+ *
+ * A standard interface for querying a streaming anomaly detector that wraps another sensor.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The detector wraps exactly one underlying sensor with callback support, which is supplied by
+ *   the system when the detector is instantiated.
+ * - The detector presents the same sensor interface as the underlying sensor.
+ * - Samples are forwarded unchanged.
+ * - Detection thresholds (stuck-at count, variance limit, allowed drift and CUSUM threshold) are
+ *   specified when the detector is instantiated.
+ * - For devices that produce multiple values (e.g., pressure and altitude), detection is
+ *   performed on the primary measurement (pressure).
+ * - Anomaly flags are "sticky": once raised, a flag remains set until it is cleared with
+ *   clearAnomalies().
+ * - Error callbacks are invoked once when a flag is first raised, not on every anomalous sample.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Errors reported by the underlying sensor are forwarded unchanged. They do not set any anomaly
+ *   flags.
+ *
+ * ## Implementation Notes
+ *
+ * - All statistics must use constant memory and O(1) integer operations per sample. See the file
+ *   documentation for the reference update equations.
+ * - The anomaly flags are written from the sample path and read by system code. Implementations
+ *   should use an atomic fetch-or to set flags and an atomic exchange to clear them.
+ */
+typedef struct
+{
+	/** Get the current anomaly flags
+	 *
+	 * @returns A bitmask of AnomalyFlags that have been raised since the flags were last cleared.
+	 */
+	uint8_t (*getAnomalies)(void);
+
+	/** Clear anomaly flags and reset detection state
+	 *
+	 * The detection statistics are reset, so that the detector re-learns the signal after a
+	 * recovery action (e.g., a sensor restart).
+	 *
+	 * @post No anomaly flags are set.
+	 */
+	void (*clearAnomalies)(void);
+} AnomalyDetector;
+
+#endif // VIRTUAL_ANOMALY_DETECTOR_H_
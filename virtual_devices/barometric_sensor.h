@@ -192,6 +192,7 @@ typedef void (*BarometricErrorCb)(void);
  * - Note that the callback registration functions do not support error handling.
  *   We recommend that implementers trigger an assert() or other crash if a callback
  *   cannot be added to a list due to exceeding fixed size constraints.
+ * - interface_patterns/observer.h provides a reusable implementation of the callback lists.
  */
 typedef struct
 {
@@ -348,10 +349,12 @@ typedef struct
  * ## Implementation Notes
  *
  * - readPressure() should be a non-blocking call. It should not directly query the sensor and
- *   wait for a response, but should instead send a request to a queue of some type.
+ *   wait for a response, but should instead send a request to a queue of some type
+ *   (see os/queue.h).
  * - Note that the callback registration functions do not support error handling.
  *   We recommend that implementers trigger an assert() or other crash if a callback
  *   cannot be added to a list due to exceeding fixed size constraints.
+ * - interface_patterns/observer.h provides a reusable implementation of the callback lists.
  */
 typedef struct
 {
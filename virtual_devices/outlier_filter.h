@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef VIRTUAL_OUTLIER_FILTER_H_
+#define VIRTUAL_OUTLIER_FILTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file outlier_filter.h
+ * Example interface for controlling an outlier-rejection stage that decorates a sensor.
+ *
+ * Like the smoothing filter in sensor_filter.h, an outlier filter wraps another sensor instance
+ * and presents the same interface as the sensor it wraps (e.g., BarometricSensor_withCb).
+ * Samples that are judged to be outliers (e.g., a pressure spike caused by a door slamming) are
+ * not dispatched to registered callbacks. A caller that reads a value directly still receives
+ * it, since the read itself succeeded.
+ *
+ * ## Filter Model
+ *
+ * The reference filter is a sliding-window Hampel filter. A sample x is an outlier if:
+ *
+ *     |x - median(window)| > threshold * max(scale(window), min_scale)
+ *
+ * Where scale(window) is an estimate of the spread of the samples in the window, and min_scale is
+ * a configured floor. Without the floor, a flat or coarsely quantized signal drives the scale to
+ * 0, after which every sample that differs from the median is rejected. The floor should be at
+ * least the sensor's noise level or resolution (e.g., a few LSBs).
+ *
+ * The window has a fixed size w, which is specified when the filter is instantiated, so the
+ * memory footprint is fixed. To keep the cost of each sample at O(log w):
+ *
+ * - Samples are stored in a ring buffer (insertion order) and in a sorted index. Two indexed
+ *   heaps (a max-heap below the median and a min-heap above it), with a position map from each
+ *   ring buffer slot to its heap location, give O(log w) insert, remove, and median in exactly
+ *   w entries. An indexable skip list backed by a fixed array of w nodes is an alternative.
+ *   Heaps with lazy deletion are not suitable, since stale entries accumulate beyond w and the
+ *   memory footprint is no longer fixed.
+ * - For small windows (w <= 16), a sorted array with binary search and a short memmove is
+ *   usually faster in practice.
+ * - The exact median absolute deviation requires O(w) work per sample. Instead, the scale is
+ *   tracked as an exponential moving average of |x - median| for accepted samples, which costs
+ *   O(1) and is updated with a shift (see sensor_filter.h).
+ *
+ * All computations use the native fixed-point format of the samples.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Replace outliers with the window median instead of dropping them
+ * - Use a fixed absolute threshold (e.g., 0.5 hPa) instead of a threshold relative to the spread
+ * - Report rejected samples through a dedicated callback
+ * - Allow the window size to be changed at runtime (requires a maximum window size to keep the
+ *   memory footprint fixed)
+ */
+
+/** Virtual Outlier Filter Control Interface
+ *
+ * A standard interface for configuring an outlier-rejection decorator that wraps another sensor.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The filter wraps exactly one underlying sensor instance, which is supplied by the system
+ *   when the filter is instantiated.
+ * - The filter presents the same sensor interface as the underlying sensor.
+ * - The window size is fixed when the filter is instantiated.
+ * - The initial threshold and minimum scale are specified when the filter is instantiated.
+ * - Accepted samples are passed through unchanged.
+ * - For devices that produce multiple values (e.g., pressure and altitude), the outlier test
+ *   is performed on the primary measurement (pressure). If it is rejected, none of the values
+ *   in the sample are dispatched.
+ * - Until the window has been filled, all valid samples are accepted.
+ *
+ * ## Undesired event assumptions
+ *
+ * - A rejected sample is not an error in the underlying device, so it is reported as valid:
+ * 	- When a read function produces a rejected sample, it will return true, and the output
+ *    parameter (if not NULL) will be updated, as it would be by the underlying sensor.
+ * 	- Error callbacks are not invoked.
+ * 	- The sample is not dispatched to "new sample" callbacks. This is the one intended deviation
+ *    from the postconditions of the wrapped interface (e.g., BarometricSensor_withCb): a valid
+ *    measurement does not always produce a "new sample" callback.
+ * 	- The number of rejected samples can be monitored with getRejectedCount().
+ * - Errors reported by the underlying device are forwarded unchanged.
+ * - Requests for an unsupported threshold or minimum scale will be rejected, and the current
+ *   configuration will remain unchanged.
+ *
+ * ## Implementation Notes
+ *
+ * - Rejected samples should still be added to the window. Otherwise, a genuine step change in the
+ *   measured value would be rejected forever.
+ * - Per-sample cost must be O(log w) or better. See the file documentation for the reference
+ *   approach.
+ */
+typedef struct
+{
+	/** Set the rejection threshold and minimum scale
+	 *
+	 * @post If the values are supported, subsequent samples are tested against the new values.
+	 * @post If either value is not supported, the configuration is unchanged.
+	 *
+	 * @param[in] threshold
+	 *  The maximum distance from the window median, as a multiple of the window's scale estimate.
+	 *  The threshold is specified as an unsigned 16-bit fixed-point number in format UQ8.8.
+	 *  A typical value is 3.0 (0x0300).
+	 * @param[in] min_scale
+	 *  The minimum scale estimate used in the outlier test. Specified in the same units and
+	 *  fixed-point format as the primary measurement (e.g., UQ22.10 hPa for pressure).
+	 *  0 is not supported.
+	 *
+	 * @returns True if the values were applied, false if either value is not supported.
+	 */
+	bool (*setThreshold)(uint16_t threshold, uint32_t min_scale);
+
+	/** Get the number of rejected samples
+	 *
+	 * @returns The number of samples rejected since the filter was created or last reset.
+	 *  The counter will saturate at UINT32_MAX.
+	 */
+	uint32_t (*getRejectedCount)(void);
+
+	/** Reset the filter state
+	 *
+	 * Clear the sample window, the scale estimate, and the rejected sample counter.
+	 *
+	 * @post All valid samples will be accepted until the window has been refilled.
+	 */
+	void (*reset)(void);
+} OutlierFilter;
+
+#endif // VIRTUAL_OUTLIER_FILTER_H_
@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef VIRTUAL_SENSOR_ALARM_H_
+#define VIRTUAL_SENSOR_ALARM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file sensor_alarm.h
+ * Example interface for threshold alarms evaluated in the sample producer's context.
+ *
+ * Alarms such as "temperature above 85 °C" are often evaluated by a subscriber after the sample
+ * has been handed off to another thread. For safety actions, that hand-off adds latency. The
+ * alarm engine described here is evaluated directly in the sample-publish path of a sensor with
+ * callback support (e.g., TemperatureSensor_withCb or BarometricSensor_withCb): when the sensor
+ * produces a new valid sample, it evaluates the alarm table *before* dispatching the sample to
+ * its "new sample" callbacks. Only alarms that change state are dispatched, to a separate list of
+ * alarm callbacks.
+ *
+ * ## Rule Table
+ *
+ * Alarms are described by a constant table of SensorAlarmRule entries, supplied when the sensor
+ * is instantiated. The table can live in flash. Each rule compares one value from the sample
+ * against a threshold, with hysteresis.
+ *
+ * To keep evaluation branch-free, "below" rules are normalized when the engine is created by
+ * negating the value and both thresholds. Every rule then reduces to the same integer
+ * comparisons, and the new alarm state is computed with bitwise operations:
+ *
+ *     above_set   = (value > set_threshold);
+ *     above_clear = (value > clear_threshold);
+ *     active      = above_set | (active & above_clear);
+ *
+ * The engine packs the state of each rule into a bitmask. Rising and falling edges are computed
+ * as (active & ~previous) and (~active & previous). If both are zero (the common case), no alarm
+ * callbacks are invoked.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Support adding and removing rules at runtime (requires synchronization with the sample path)
+ * - Add a debounce count, so an alarm is only raised after N consecutive samples
+ * - Report the sample that caused the alarm in the callback
+ * - Dispatch only rising edges, and let callers poll getActiveAlarms() for clears
+ */
+
+/** Values that a SensorAlarmRule can be evaluated against */
+typedef enum
+{
+	/// The primary measurement of the sample (e.g., pressure, temperature, humidity).
+	ALARM_SOURCE_VALUE = 0,
+	/// The secondary measurement of the sample (e.g., altitude for barometric sensors).
+	ALARM_SOURCE_SECONDARY_VALUE,
+	/// The change in the primary measurement since the previous valid sample.
+	ALARM_SOURCE_VALUE_DELTA,
+} SensorAlarmSource;
+
+/** Threshold comparison direction of a SensorAlarmRule */
+typedef enum
+{
+	/// The alarm is raised when the value rises above the set threshold.
+	ALARM_ABOVE = 0,
+	/// The alarm is raised when the value falls below the set threshold.
+	ALARM_BELOW,
+} SensorAlarmDirection;
+
+/** Alarm rule description
+ *
+ * Thresholds are specified in the units and fixed-point format of the selected source.
+ * For example, a rule for temperature above 85 °C uses the Q7.8 value 85 * 256.
+ *
+ * For ALARM_ABOVE rules, clearThreshold should be less than or equal to setThreshold.
+ * For ALARM_BELOW rules, clearThreshold should be greater than or equal to setThreshold.
+ * The difference is the width of the hysteresis band.
+ */
+typedef struct
+{
+	/// Threshold at which the alarm is raised.
+	int32_t setThreshold;
+	/// Threshold at which the alarm is cleared.
+	int32_t clearThreshold;
+	/// The value the rule is evaluated against.
+	SensorAlarmSource source;
+	/// The comparison direction.
+	SensorAlarmDirection direction;
+} SensorAlarmRule;
+
+/** Callback function prototype for alarm state changes
+ *
+ * This callback is invoked from the sensor's sample-publish path, before "new sample" callbacks
+ * are invoked. It must be kept very small. We recommend performing the safety action directly
+ * (e.g., setting a GPIO) or signaling another thread.
+ *
+ * @param[in] raised A bitmask of the alarms that were raised by the latest sample.
+ *  Bit n corresponds to entry n of the rule table.
+ * @param[in] cleared A bitmask of the alarms that were cleared by the latest sample.
+ */
+typedef void (*SensorAlarmCb)(uint32_t raised, uint32_t cleared);
+
+/** Virtual Sensor Alarm Interface
+ *
+ * A standard interface for subscribing to threshold alarms evaluated by a sensor.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The rule table is supplied when the sensor is instantiated, and does not change afterward.
+ * - The rule table contains at most 32 rules.
+ * - All alarms are inactive when the sensor is instantiated.
+ * - Alarms are evaluated on every valid sample, before "new sample" callbacks are invoked.
+ * - Alarm callbacks are only invoked when at least one alarm changes state.
+ * - ALARM_SOURCE_VALUE_DELTA rules are not evaluated on the first valid sample.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Invalid samples are not evaluated. Alarm state is unchanged.
+ *
+ * ## Implementation Notes
+ *
+ * - Rule evaluation should be branch-free. See the file documentation for the reference approach.
+ * - Normalize the rule table once, when the sensor is instantiated, not on each sample.
+ * - Note that the callback registration functions do not support error handling.
+ *   We recommend that implementers trigger an assert() or other crash if a callback
+ *   cannot be added to a list due to exceeding fixed size constraints.
+ */
+typedef struct
+{
+	/** Get the current alarm state
+	 *
+	 * @returns A bitmask of active alarms. Bit n corresponds to entry n of the rule table.
+	 */
+	uint32_t (*getActiveAlarms)(void);
+
+	/** Register a SensorAlarmCb function
+	 *
+	 * This function will add the callback input to a list of functions to execute
+	 * when an alarm changes state.
+	 *
+	 * @pre callback is not NULL
+	 * @post callback is added to the list of alarm callbacks.
+	 *
+	 * @param[in] callback
+	 * 	The callback function pointer to register on the alarm callback list.
+	 */
+	void (*registerAlarmCb)(const SensorAlarmCb callback);
+
+	/** Remove a registered SensorAlarmCb function
+	 *
+	 * This function will remove a callback function from the registered list of
+	 * alarm callbacks. If the function has not been previously registered,
+	 * the parameter will be ignored and the list will be unchanged.
+	 *
+	 * @post callback function pointer is not present on the list of alarm callbacks.
+	 *
+	 * @param[in] callback
+	 * 	The callback function pointer to remove from the alarm callback list.
+	 */
+	void (*unregisterAlarmCb)(const SensorAlarmCb callback);
+} SensorAlarms;
+
+#endif // VIRTUAL_SENSOR_ALARM_H_
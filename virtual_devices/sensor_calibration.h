@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef VIRTUAL_SENSOR_CALIBRATION_H_
+#define VIRTUAL_SENSOR_CALIBRATION_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file sensor_calibration.h
+ * Example interface for an online calibration stage that decorates a sensor.
+ *
+ * A calibration stage wraps another sensor instance (e.g., a BarometricSensor or
+ * TemperatureSensor) and presents the same interface. Each value read from the underlying sensor
+ * is corrected with a linear model before it is returned or dispatched:
+ *
+ *     corrected = ((gain * raw) >> 16) + offset
+ *
+ * Applying the correction costs one multiply-add (in a 64-bit intermediate) and a shift.
+ *
+ * ## Derived Values
+ *
+ * For devices that report a value derived from the primary measurement (e.g., a barometric
+ * sensor's altitude, derived from pressure), the derived value must stay consistent with the
+ * corrected primary value. Recomputing it would put a full barometric formula evaluation on the
+ * read path, so the stage applies a linearized correction instead:
+ *
+ *     corrected_altitude = raw_altitude + (((corrected_pressure - raw_pressure) * slope) >> 16)
+ *
+ * Where slope is dh/dp, the local sensitivity of altitude to pressure, in meters per hPa
+ * (Q15.16, negative). In the troposphere, dh/dp = -(R * T) / (g * M * p), which is about
+ * -8.3 m/hPa at sea level and -15 m/hPa at 500 hPa. The slope is re-evaluated at the current raw
+ * pressure when the coefficients are re-solved (see below) or set, not on every read, so the
+ * read path only adds one multiply-add. Calibration corrections are small (a few hPa), so the
+ * error of the linearization is small compared to the correction itself.
+ *
+ * The stage can also learn the gain and offset while the system runs, by comparing the raw
+ * values from the wrapped sensor against a reference source. The reference is another instance
+ * of the same sensor interface, supplied by the system when the stage is instantiated. It can be
+ * a trusted sensor, or a consensus of peers presented as a single sensor (see sensor_voter.h).
+ *
+ * ## Learning Model
+ *
+ * The reference implementation fits reference = gain * raw + offset with incremental least
+ * squares. For each pair of (raw, reference) samples, the stage updates four running sums:
+ * sum(x), sum(y), sum(x*x), and sum(x*y). The sums decay exponentially (by subtracting
+ * sum >> k before adding the new term), so older samples are gradually forgotten and slow drift
+ * is tracked. Samples should be centered on a fixed operating point (e.g., 1013.25 hPa or 25 °C)
+ * before they are accumulated, which keeps the sums within 64 bits.
+ *
+ * Solving for the gain and offset requires a division, so the coefficients are recomputed at a
+ * low rate (e.g., every 64 sample pairs). The read path only uses the most recently solved
+ * coefficients.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Support offset-only calibration, which removes the multiply from the read path
+ * - Add a temperature coefficient for sensors whose drift depends on temperature
+ * - Accept reference values directly (e.g., from a ground station) instead of from a sensor
+ * - Add a checksum to the coefficient structure for persistent storage
+ */
+
+/** Linear calibration coefficients
+ *
+ * The coefficients are compact (8 bytes) so that they can be stored in non-volatile memory and
+ * restored with setCoefficients() at startup.
+ */
+typedef struct
+{
+	/** Gain applied to the raw value.
+	 *
+	 * Specified as a signed 32-bit fixed-point number in format Q15.16. A gain of 1.0 is 0x10000.
+	 */
+	int32_t gain;
+
+	/** Offset added after the gain has been applied.
+	 *
+	 * Specified in the same units and fixed-point format as the wrapped sensor's values
+	 * (e.g., UQ22.10 hPa for pressure, Q7.8 °C for temperature).
+	 */
+	int32_t offset;
+} SensorCalibrationCoefficients;
+
+/** Virtual Sensor Calibration Interface
+ *
+ * A standard interface for managing an online calibration stage that wraps another sensor.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The stage wraps exactly one underlying sensor instance, which is supplied by the system
+ *   when the stage is instantiated.
+ * - The stage presents the same sensor interface as the underlying sensor.
+ * - Corrected values use the same units and fixed-point format as the underlying sensor.
+ * - The default coefficients are gain = 1.0 and offset = 0, which leave values unchanged.
+ * - Learning requires a reference source, which is supplied by the system when the stage is
+ *   instantiated. If no reference is supplied, the coefficients can only be changed with
+ *   setCoefficients().
+ * - Learning is disabled until it is explicitly enabled.
+ * - For devices that produce multiple values (e.g., pressure and altitude), the coefficients
+ *   apply to the primary measurement (pressure). Derived values (altitude) are adjusted by the
+ *   linearized correction described in the file documentation, so that each reported pair is
+ *   consistent.
+ *
+ * ## Undesired event assumptions
+ *
+ * - If either the underlying sensor or the reference source produces an invalid sample, that
+ *   sample pair is not used for learning.
+ * - If the least-squares solution is degenerate (e.g., all raw samples are identical), the gain
+ *   is left unchanged and only the offset is updated.
+ * - Corrected values are saturated to the range of the sensor's fixed-point format.
+ *
+ * ## Implementation Notes
+ *
+ * - The read path must cost no more than one multiply-add per reported value on top of the
+ *   underlying read.
+ *   Learning work should be performed in the reference sampling path, not on every read.
+ * - The coefficients are read on the sample path and written when they are re-solved. Use a
+ *   single 64-bit atomic store, a sequence lock, or double buffering to avoid torn reads.
+ */
+typedef struct
+{
+	/** Get the current calibration coefficients
+	 *
+	 * @pre coefficients is not NULL.
+	 * @post The data pointed to by coefficients holds the coefficients currently applied to
+	 *       samples.
+	 *
+	 * @param[inout] coefficients Pointer which will be used to store the current coefficients.
+	 */
+	void (*getCoefficients)(SensorCalibrationCoefficients* const coefficients);
+
+	/** Set the calibration coefficients
+	 *
+	 * This is normally used at startup to restore coefficients from non-volatile memory.
+	 * Learning (if enabled) continues from the supplied coefficients.
+	 *
+	 * @pre coefficients is not NULL.
+	 * @post Subsequent samples are corrected with the supplied coefficients.
+	 *
+	 * @param[in] coefficients The coefficients to apply.
+	 */
+	void (*setCoefficients)(const SensorCalibrationCoefficients* const coefficients);
+
+	/** Enable or disable learning
+	 *
+	 * Disabling learning freezes the current coefficients, which are still applied to samples.
+	 *
+	 * @param[in] enable True to learn coefficients from the reference source, false to freeze them.
+	 *
+	 * @returns True if the request was applied, false if learning is not supported
+	 *  (e.g., no reference source was supplied).
+	 */
+	bool (*setLearningEnabled)(bool enable);
+} SensorCalibration;
+
+#endif // VIRTUAL_SENSOR_CALIBRATION_H_
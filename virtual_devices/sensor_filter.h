@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef VIRTUAL_SENSOR_FILTER_H_
+#define VIRTUAL_SENSOR_FILTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file sensor_filter.h
+ * Example interface for controlling a smoothing filter that decorates a sensor.
+ *
+ * A filtering virtual device wraps another sensor instance and presents the *same* interface
+ * as the sensor it wraps: a filtered barometer is still a BarometricSensor (or
+ * BarometricSensor_withCb), a filtered thermometer is still a TemperatureSensor, and so on.
+ * Application code that reads the filtered device does not know (or care) that filtering is
+ * taking place. This allows the filter to be applied once, at the source, rather than in each
+ * consumer of the sample stream.
+ *
+ * The only new interface required is the one defined here, which is used by the part of the
+ * system that configures the filter. General application code should not need it.
+ *
+ * ## Filter Model
+ *
+ * The reference filter is a first-order IIR filter (exponential moving average):
+ *
+ *     y[n] = y[n-1] + alpha * (x[n] - y[n-1])
+ *
+ * We restrict alpha to powers of two (alpha = 2^-shift), so the filter can be computed with
+ * one subtraction, one arithmetic shift, and one addition in the native fixed-point format of the
+ * sample:
+ *
+ *     y += (x - y) >> shift;
+ *
+ * No floating point or multiplication is required. Implementations should keep the filter state
+ * in a wider type than the sample (e.g., int64_t for 32-bit samples, int32_t for 16-bit samples)
+ * with additional fractional bits, so that small steps are not lost to truncation.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Specify alpha as a fixed-point coefficient (e.g., UQ0.16) to allow arbitrary smoothing
+ *   factors at the cost of a multiply per sample
+ * - Support higher-order IIR filters by accepting a table of coefficients
+ * - Use separate smoothing factors for each value produced by a device (e.g., pressure and
+ *   altitude)
+ * - Make the filtered device a separate interface type instead of re-using the sensor interface
+ */
+
+/** Virtual Sensor Filter Control Interface
+ *
+ * A standard interface for configuring a filtering decorator that wraps another sensor.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The filter wraps exactly one underlying sensor instance, which is supplied by the system
+ *   when the filter is instantiated.
+ * - The filter presents the same sensor interface as the underlying sensor
+ *   (e.g., BarometricSensor, TemperatureSensor, HumiditySensor, or their `_withCb` variants).
+ * - Filtered values use the same units and fixed-point format as the underlying sensor.
+ * - The filter is an exponential moving average with alpha = 2^-shift.
+ * 	- A shift of 0 disables filtering: samples pass through unchanged.
+ * 	- Larger shifts produce more smoothing and a slower response to change.
+ * - The first valid sample after creation or reset() initializes the filter state directly.
+ * - Invalid samples from the underlying device are not applied to the filter. The read function
+ *   reports the failure, and the filter state remains unchanged.
+ * - For devices that produce multiple values (e.g., pressure and altitude), the same smoothing
+ *   factor is applied to each value independently.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Requests for an unsupported shift value will be rejected, and the current configuration will
+ *   remain unchanged.
+ *
+ * ## Implementation Notes
+ *
+ * - Filter state should be updated only with integer operations. See the file documentation for
+ *   the reference update equation.
+ * - Callback-based filters (wrapping a `_withCb` interface) should register their own new sample
+ *   and error callbacks with the underlying device when created. When the underlying device
+ *   reports a new sample, the filter updates its state and invokes its own registered callbacks
+ *   with the filtered sample. Error callbacks should be forwarded unchanged.
+ * - Reads of the filtered device that pass a NULL output parameter (to trigger a sample for
+ *   callback consumers only) should be passed through to the underlying device. The filtered
+ *   value will be published by the callback path.
+ * - Because callbacks in these interfaces do not carry a context pointer, each filter instance
+ *   needs its own set of callback functions. A macro that generates the instance functions is
+ *   a common approach.
+ */
+typedef struct
+{
+	/** Set the smoothing factor of the filter
+	 *
+	 * The filter will use alpha = 2^-shift for subsequent samples. Existing filter state is
+	 * retained, so the output does not jump when the smoothing factor is changed.
+	 *
+	 * @post If shift is supported, subsequent samples are filtered with the new factor.
+	 * @post If shift is not supported, the configuration is unchanged.
+	 *
+	 * @param[in] shift
+	 *  The power-of-two divisor applied to the filter error term. 0 disables filtering.
+	 *  Implementations may limit the maximum value (e.g., 15 for 16-bit samples).
+	 *
+	 * @returns True if the smoothing factor was applied, false if the value is not supported.
+	 */
+	bool (*setSmoothingShift)(uint8_t shift);
+
+	/** Reset the filter state
+	 *
+	 * Discard the current filter state. The next valid sample from the underlying device will be
+	 * used as the initial filter output. This is useful after the underlying device has been
+	 * restarted, or after a known step change in the measured value.
+	 *
+	 * @post The filter will be re-initialized by the next valid sample.
+	 */
+	void (*reset)(void);
+} SensorFilter;
+
+#endif // VIRTUAL_SENSOR_FILTER_H_
@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef VIRTUAL_SENSOR_VOTER_H_
+#define VIRTUAL_SENSOR_VOTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file sensor_voter.h
+ * Example interface for a redundant sensor voting aggregator.
+ *
+ * Systems with redundant sensors (e.g., three barometers) often have application code read each
+ * sensor and vote on the result. A voting aggregator moves that logic below the interface: it
+ * wraps N underlying instances of the same sensor type and presents them as a single sensor with
+ * the same interface (BarometricSensor, TemperatureSensor, their `_withCb` variants, etc.).
+ * Application code reads the aggregate exactly as it would read one sensor.
+ *
+ * The interface defined here is used by system code to monitor and manage the health of the
+ * individual sensors. General application code should not need it.
+ *
+ * ## Voting Model
+ *
+ * - Each read produces one candidate value from each active (non-excluded) sensor.
+ * - The aggregate value is the mid-value of the candidates:
+ * 	- With an odd number of candidates, the median is used. For three sensors, this is a
+ *    branch-light min/max network: max(min(a, b), min(max(a, b), c)).
+ * 	- With an even number of candidates, the mean of the two middle values is used.
+ * 	- With one candidate, that value is used directly.
+ * - For devices that produce multiple values (e.g., pressure and altitude), the vote is performed
+ *   on the primary measurement, and all values from the selected sensor are reported together.
+ *   With an even number of candidates, the values from the lower middle candidate are used.
+ *
+ * ## Sampling Model
+ *
+ * The aggregate should cost no more latency than a single sensor:
+ *
+ * - For `_asyncWithCb` devices, readSample() requests a sample from every active sensor at once.
+ *   The vote is performed when all active sensors have responded, or when an
+ *   implementation-defined deadline expires (sensors that miss the deadline do not vote).
+ * - For `_withCb` devices, the aggregator keeps the most recent sample published by each sensor.
+ *   A read triggers a sample on one sensor (round-robin) and votes over the cached values.
+ * - For blocking devices, the same round-robin approach applies: each read blocks on only one
+ *   sensor.
+ *
+ * ## Exclusion and Readmission
+ *
+ * A sensor is excluded as soon as it reports an error or an invalid sample, so that a faulty
+ * sensor never contributes to a vote. A single transient fault (e.g., one failed bus transfer)
+ * should not remove a sensor permanently, so excluded sensors keep being sampled:
+ *
+ * - Excluded sensors remain in the round-robin rotation, and receive readSample() requests along
+ *   with the active sensors. Their samples are checked for validity, but do not vote.
+ * - Each excluded sensor has a count of consecutive valid samples. Any error or invalid sample
+ *   resets it to 0. When it reaches the readmission threshold, the sensor is readmitted.
+ * - Every change to the active set (automatic or explicit) is reported through registered
+ *   SensorVoterCb callbacks, so that system code can log it, raise a maintenance flag, or
+ *   react when redundancy is lost.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Exclude a sensor whose value disagrees with the vote by more than a fixed tolerance
+ * - Use a weighted vote (e.g., inverse-variance weighting) instead of mid-value selection
+ * - Report the number of voting sensors alongside each sample
+ * - Support more than 32 sensors by replacing the active mask with an array
+ * - Stop sampling sensors that have been excluded by system code, to save bus time
+ */
+
+/** Callback function prototype for changes to the set of active sensors
+ *
+ * This callback is invoked from the sample or error callback path of the underlying sensor that
+ * caused the change, or from excludeSensor() and readmitSensor(). It must be kept very small.
+ * We recommend recording the change or signaling another thread.
+ *
+ * @param[in] excluded A bitmask of the sensors that were excluded. Bit n corresponds to sensor n.
+ * @param[in] readmitted A bitmask of the sensors that were readmitted.
+ */
+typedef void (*SensorVoterCb)(uint32_t excluded, uint32_t readmitted);
+
+/** Virtual Sensor Voter Interface
+ *
+ * A standard interface for monitoring and managing the sensors behind a voting aggregator.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The aggregator wraps between 1 and 32 underlying sensors of the same type, which are supplied
+ *   by the system when the aggregator is instantiated.
+ * - Sensors are identified by their index (0 to N-1) in the order they were supplied.
+ * - The aggregator presents the same sensor interface as the underlying sensors.
+ * - Values use the same units and fixed-point format as the underlying sensors.
+ * - Each sensor is either active (participates in votes) or excluded.
+ * 	- All sensors are active when the aggregator is instantiated.
+ * 	- A sensor is excluded automatically when it issues an error callback or returns an invalid
+ *    sample.
+ * 	- A sensor that was excluded automatically is readmitted automatically after a number of
+ *    consecutive valid samples, which is specified when the aggregator is instantiated. A
+ *    threshold of 0 disables automatic readmission.
+ * 	- A sensor excluded with excludeSensor() is only readmitted by readmitSensor().
+ * - SensorVoterCb callbacks are invoked on every change to the set of active sensors.
+ *
+ * ## Undesired event assumptions
+ *
+ * - Errors reported by an individual sensor are not forwarded to the aggregate's error callbacks.
+ *   The sensor is excluded instead, and SensorVoterCb callbacks are invoked.
+ * - If all sensors have been excluded, the aggregate will report invalid samples and issue its
+ *   own error callbacks.
+ *
+ * ## Implementation Notes
+ *
+ * - Because callbacks in these interfaces do not carry a context pointer, the aggregator must
+ *   register a separate error (and new sample) callback with each underlying sensor so that it
+ *   can identify the source. A macro that generates a function per sensor index is a common
+ *   approach.
+ * - The active mask is read from the sample path and written from the error callback path.
+ *   Implementations that support concurrent callbacks should update it atomically.
+ * - The consecutive valid sample counts are only updated from the sample path, one per sensor.
+ * - Note that the callback registration functions do not support error handling.
+ *   We recommend that implementers trigger an assert() or other crash if a callback
+ *   cannot be added to a list due to exceeding fixed size constraints.
+ */
+typedef struct
+{
+	/** Get the set of active sensors
+	 *
+	 * @returns A bitmask of active sensors. Bit n is set if sensor n is participating in votes.
+	 */
+	uint32_t (*getActiveSensors)(void);
+
+	/** Exclude a sensor from voting
+	 *
+	 * System code can use this to remove a sensor that it knows to be faulty, even if the sensor
+	 * has not reported an error.
+	 *
+	 * @post If index is valid, the sensor no longer participates in votes.
+	 *
+	 * @param[in] index The index of the sensor to exclude.
+	 *
+	 * @returns True if the sensor was excluded, false if the index is invalid.
+	 */
+	bool (*excludeSensor)(uint8_t index);
+
+	/** Re-admit an excluded sensor
+	 *
+	 * System code should call this once a faulty sensor has been recovered (e.g., restarted), if
+	 * it was excluded with excludeSensor() or automatic readmission is disabled. The sensor is
+	 * readmitted immediately, without waiting for valid samples.
+	 *
+	 * @post If index is valid, the sensor participates in subsequent votes.
+	 *
+	 * @param[in] index The index of the sensor to re-admit.
+	 *
+	 * @returns True if the sensor is active, false if the index is invalid.
+	 */
+	bool (*readmitSensor)(uint8_t index);
+
+	/** Register a SensorVoterCb function
+	 *
+	 * This function will add the callback input to a list of functions to execute
+	 * when the set of active sensors changes.
+	 *
+	 * @pre callback is not NULL
+	 * @post callback is added to the list of active set callbacks.
+	 *
+	 * @param[in] callback
+	 * 	The callback function pointer to register on the active set callback list.
+	 */
+	void (*registerActiveSetCb)(const SensorVoterCb callback);
+
+	/** Remove a registered SensorVoterCb function
+	 *
+	 * This function will remove a callback function from the registered list of
+	 * active set callbacks. If the function has not been previously registered,
+	 * the parameter will be ignored and the list will be unchanged.
+	 *
+	 * @post callback function pointer is not present on the list of active set callbacks.
+	 *
+	 * @param[in] callback
+	 * 	The callback function pointer to remove from the active set callback list.
+	 */
+	void (*unregisterActiveSetCb)(const SensorVoterCb callback);
+} SensorVoter;
+
+#endif // VIRTUAL_SENSOR_VOTER_H_
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef VIRTUAL_TEMPERATURE_FUSION_H_
+#define VIRTUAL_TEMPERATURE_FUSION_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file temperature_fusion.h
+ * Example interface for fusing multiple temperature sensors into a single estimate.
+ *
+ * A temperature fusion device combines up to eight TemperatureSensor_withCb instances with
+ * different noise characteristics into a single, confidence-weighted estimate. The fusion device
+ * itself implements TemperatureSensor_withCb (see temperature_sensor.h), so consumers read and
+ * subscribe to it exactly as they would a single sensor.
+ *
+ * Unlike the voting aggregator in sensor_voter.h, which selects a mid-value to tolerate faulty
+ * sensors, fusion assumes all inputs are healthy but imprecise, and averages them to reduce noise.
+ *
+ * ## Fusion Model
+ *
+ * The estimate is the inverse-variance weighted mean of the latest sample from each sensor:
+ *
+ *     estimate = sum(w_i * t_i),  where w_i = (1 / var_i) / sum(1 / var_j)
+ *
+ * The normalized weights only change when a sensor's variance changes or a sensor is excluded
+ * or re-included, so they are recomputed (in Q16) at those times only. When sensor i calls back
+ * with a new sample, the estimate is updated incrementally with one multiply-add:
+ *
+ *     estimate_q24 += w_i * (t_new - t_old);
+ *
+ * Samples are Q7.8 and weights are Q16, so the estimate is kept in Q7.24. Use a 64-bit
+ * accumulator unless all inputs are known to stay well inside the Q7.8 range. The estimate is
+ * rounded back to Q7.8 before it is published.
+ *
+ * The variance of the fused estimate is 1 / sum(1 / var_j), which is always smaller than the
+ * variance of the best individual sensor. It is reported as the confidence of the estimate.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Estimate each sensor's variance online (see anomaly_detector.h for a suitable estimator)
+ *   instead of supplying it
+ * - Weight samples by age, so a sensor that has stopped reporting loses influence gradually
+ * - Report the fused variance with each published sample
+ * - Support other sensor types (e.g., humidity) with the same approach
+ */
+
+/** Virtual Temperature Fusion Interface
+ *
+ * A standard interface for managing a temperature fusion device.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The fusion device combines between 1 and 8 TemperatureSensor_withCb instances, which are
+ *   supplied by the system when the device is instantiated.
+ * - Sensors are identified by their index (0 to N-1) in the order they were supplied.
+ * - The fusion device implements TemperatureSensor_withCb. Fused temperatures are reported in °C
+ *   as a signed 16-bit fixed point integer in format Q7.8.
+ * - Each sensor has a measurement variance, specified in °C² as an unsigned 32-bit fixed-point
+ *   integer in format UQ16.16. Initial variances are supplied when the device is instantiated.
+ * - The estimate is updated whenever any sensor publishes a new sample.
+ * - A new fused sample is published only when the estimate differs from the last published
+ *   sample by more than a threshold, which is specified when the device is instantiated.
+ * - No samples are published until every sensor has reported at least one valid sample, or an
+ *   implementation-defined startup timeout has elapsed.
+ *
+ * ## Undesired event assumptions
+ *
+ * - If a sensor reports an error, it is excluded from the estimate until it publishes a new
+ *   valid sample. Errors are not forwarded to the fusion device's error callbacks.
+ * - If all sensors are excluded, the fusion device issues its own error callbacks, and reads
+ *   will report invalid samples.
+ *
+ * ## Implementation Notes
+ *
+ * - Each update must be O(1): recompute the normalized weights only when the set of contributing
+ *   sensors or their variances change. See the file documentation for the reference approach.
+ * - Because callbacks in these interfaces do not carry a context pointer, the fusion device must
+ *   register a separate callback with each underlying sensor so that it can identify the source.
+ */
+typedef struct
+{
+	/** Set the measurement variance of an input sensor
+	 *
+	 * @post If index is valid, subsequent estimates will use the new variance.
+	 *
+	 * @param[in] index The index of the sensor.
+	 * @param[in] variance The sensor's measurement variance in °C².
+	 *  Variance is specified as an unsigned 32-bit fixed-point number in format UQ16.16.
+	 *  A variance of 0 is not allowed.
+	 *
+	 * @returns True if the variance was applied, false if the index or variance is invalid.
+	 */
+	bool (*setSensorVariance)(uint8_t index, uint32_t variance);
+
+	/** Get the variance of the fused estimate
+	 *
+	 * @pre variance is not NULL.
+	 * @post If an estimate is available, the data pointed to by variance will be updated.
+	 * @post If no estimate is available, the data pointed to by variance will remain unchanged.
+	 *
+	 * @param[inout] variance The variance of the fused estimate in °C².
+	 *  Variance is specified as an unsigned 32-bit fixed-point number in format UQ16.16.
+	 *
+	 * @returns True if an estimate is available, false otherwise.
+	 */
+	bool (*getFusedVariance)(uint32_t* const variance);
+} TemperatureFusion;
+
+#endif // VIRTUAL_TEMPERATURE_FUSION_H_
@@ -143,6 +143,7 @@ typedef void (*TemperatureErrorCb)(void);
  * - Note that the callback registration functions do not support error handling.
  *   We recommend that implementers trigger an assert() or other crash if a callback
  *   cannot be added to a list due to exceeding fixed size constraints.
+ * - interface_patterns/observer.h provides a reusable implementation of the callback lists.
  */
 typedef struct
 {
@@ -0,0 +1,225 @@
+// SPDX-FileCopyrightText: © 2022 Embedded Artistry LLC <contact@embeddedartistry.com>
+// SPDX-License-Identifier: MIT
+
+#ifndef VIRTUAL_VARIOMETER_H_
+#define VIRTUAL_VARIOMETER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @file variometer.h
+ * Example variometer (vertical speed indicator) interfaces.
+ *
+ * A variometer is a derived virtual device: it does not talk to hardware itself, but computes
+ * the rate of climb from the altitude samples published by a barometric sensor. This header
+ * defines two variations:
+ *
+ * 1. A basic interface for reading vertical speed (Variometer)
+ * 2. An interface expanded with support for callbacks (Variometer_withCb)
+ *
+ * ## Computing Vertical Speed
+ *
+ * Differentiating consecutive altitude samples amplifies sensor noise. Instead, the reference
+ * implementation registers a NewBarometricSampleCb with a BarometricSensor_withCb instance and
+ * fits a line to the last N altitude samples using least-squares linear regression. The slope of
+ * that line is the vertical speed.
+ *
+ * When samples arrive at a fixed period, the sample times within the window are always
+ * 0, 1, ..., N-1, so sum(t) and sum(t^2) are constants. Only sum(y) and sum(t*y) need to be
+ * tracked, and both can be updated in O(1) as a sample enters and another leaves the window:
+ *
+ *     sum_ty += (N - 1) * y_new + y_old - sum_y;   // shift all times down by one, add new sample
+ *     sum_y  += y_new - y_old;
+ *     slope = (N * sum_ty - sum_t * sum_y) / (N * sum_t2 - sum_t * sum_t);
+ *
+ * The denominator is a constant, so its reciprocal (scaled by the sample rate) can be
+ * pre-computed when the variometer is created. Sums should be kept in 64-bit integers.
+ * Altitude samples are fed in unmodified Q21.10, so no floating point is required.
+ *
+ * ## Modifying the Interfaces
+ *
+ * There are a number of ways you might modify this interface to suit your needs:
+ *
+ * - Change the fixed-point format of the vertical speed (e.g., to a Q16 standard)
+ * - Provide the altitude and vertical speed together in the callback
+ * - Use timestamped samples to support irregular sample periods (at the cost of tracking
+ *   sum(t) and sum(t^2) as well)
+ * - Supporting an asynchronous processing model (see barometric_sensor.h for an example)
+ */
+
+#pragma mark - Basic Interface -
+
+/** Virtual Variometer Interface
+ *
+ * A standard interface for a device which reports vertical speed.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The device reports vertical speed in meters per second (m/s)
+ * 	- Vertical speed is positive when climbing and negative when descending.
+ * 	- Vertical speed will be formatted as a 32-bit fixed-point integer with format Q21.10,
+ *    giving a resolution of 0.001 m/s.
+ * - Vertical speed is computed from the altitude samples of an underlying barometric sensor,
+ *   which is supplied by the system when the variometer is instantiated.
+ * - The underlying sensor produces samples at a fixed rate, which is specified when the
+ *   variometer is instantiated.
+ * - The device will indicate whether the current reading is valid or invalid.
+ * 	- The reading is invalid until the regression window has been filled.
+ *
+ * ## Implementation Notes
+ *
+ * - This interface, at its core, appears to be blocking. However, you can still implement this
+ *   interface in a non-blocking way. For example, you could always return the most recent
+ *   vertical speed, which is updated whenever the underlying sensor publishes a new sample.
+ */
+typedef struct
+{
+	/** Get the current vertical speed in m/s
+	 *
+	 * @pre The variometer has been properly initialized by the system.
+	 * @pre The speed parameter is not NULL.
+	 * @post If the reading is valid, the data pointed to by the speed parameter
+	 *       will be updated with the latest reading.
+	 * @post If the reading is invalid, the data pointed to by the speed parameter
+	 *       will remain unchanged.
+	 *
+	 * @param[inout] speed Current vertical speed in m/s.
+	 *  Vertical speed is specified as a signed 32-bit fixed-point number in format Q21.10.
+	 *
+	 * @returns True if the reading is valid, false if invalid (e.g., the window is not yet full).
+	 */
+	bool (*readVerticalSpeed)(int32_t* const speed);
+} Variometer;
+
+#pragma mark - With Callback Support -
+
+/** Callback function prototype for processing new vertical speed samples
+ *
+ * When a new (and valid) vertical speed sample is available, this callback function will be
+ * invoked. New samples are produced each time the underlying barometric sensor publishes a
+ * new altitude sample.
+ *
+ * The callback is not guaranteed to run on its own thread of control. We recommend
+ * keeping the implementation small. Your function implementation could take the
+ * new sample and perform some dispatching operation (e.g., add the value to a queue),
+ * ensuring that any "heavy" processing happens on a new thread.
+ *
+ * @param[in] speed The latest vertical speed sample, in m/s.
+ *
+ *  Vertical speed is specified as a signed 32-bit fixed-point number in format Q21.10.
+ */
+typedef void (*NewVerticalSpeedSampleCb)(int32_t speed);
+
+/** Callback function prototype for variometer errors
+ *
+ * When an error in the virtual variometer occurs, this callback function will be invoked.
+ * Errors reported by the underlying barometric sensor are forwarded through this callback.
+ *
+ * The callback is not guaranteed to run on its own thread of control. We recommend
+ * keeping the implementation small.
+ */
+typedef void (*VariometerErrorCb)(void);
+
+/** Virtual Variometer Interface with Callback Support
+ *
+ * A standard interface for a device which reports vertical speed. Interested parties can receive
+ * callbacks when new samples are available.
+ *
+ * ## Fundamental Assumptions
+ *
+ * - The device reports vertical speed in meters per second (m/s)
+ * 	- Vertical speed is positive when climbing and negative when descending.
+ * 	- Vertical speed will be formatted as a 32-bit fixed-point integer with format Q21.10,
+ *    giving a resolution of 0.001 m/s.
+ * - Vertical speed is computed from the samples published by an underlying
+ *   BarometricSensor_withCb, which is supplied by the system when the variometer is instantiated.
+ * - The underlying sensor produces samples at a fixed rate, which is specified when the
+ *   variometer is instantiated.
+ * - The device will notify interested parties each time a new valid vertical speed is computed.
+ * 	- No samples are published until the regression window has been filled.
+ *
+ * ## Undesired event assumptions
+ *
+ * - If the underlying sensor reports an error, the variometer will clear its regression window
+ *   and notify interested parties by issuing an error callback. Samples will be published again
+ *   once the window has been refilled.
+ *
+ * ## Implementation Notes
+ *
+ * - The vertical speed computation must be O(1) per sample. See the file documentation for the
+ *   reference update equations.
+ * - Note that the callback registration functions do not support error handling.
+ *   We recommend that implementers trigger an assert() or other crash if a callback
+ *   cannot be added to a list due to exceeding fixed size constraints.
+ */
+typedef struct
+{
+	/** Get the current vertical speed in m/s
+	 *
+	 * @pre The variometer has been properly initialized by the system.
+	 * @post If the reading is valid and the speed parameter is not NULL, the data pointed
+	 *       to will be updated with the latest reading.
+	 * @post If the reading is invalid, the data pointed to by the speed parameter
+	 *       will remain unchanged.
+	 *
+	 * @param[inout] speed Current vertical speed in m/s.
+	 *  Vertical speed is specified as a signed 32-bit fixed-point number in format Q21.10.
+	 *
+	 * @returns True if the reading is valid, false if invalid (e.g., the window is not yet full).
+	 */
+	bool (*readVerticalSpeed)(int32_t* const speed);
+
+	/** Register a NewVerticalSpeedSampleCb function
+	 *
+	 * This function will add the callback input to a list of functions to execute
+	 * when a new and valid sample is available.
+	 *
+	 * @pre callback is not NULL
+	 * @post callback is added to the list of "new sample" callbacks.
+	 *
+	 * @param[in] callback
+	 * 	The callback function pointer to register on the "new sample" callback list.
+	 */
+	void (*registerNewSampleCb)(const NewVerticalSpeedSampleCb callback);
+
+	/** Remove a registered NewVerticalSpeedSampleCb function
+	 *
+	 * This function will remove a callback function from the registered list of
+	 * "new sample" callbacks. If the function has not been previously registered,
+	 * the parameter will be ignored and the list will be unchanged.
+	 *
+	 * @post callback function pointer is not present on the list of "new sample" callbacks.
+	 *
+	 * @param[in] callback
+	 * 	The callback function pointer to remove from the "new sample" callback list.
+	 */
+	void (*unregisterNewSampleCb)(const NewVerticalSpeedSampleCb callback);
+
+	/** Register a VariometerErrorCb function
+	 *
+	 * This function will add the callback input to a list of functions to execute
+	 * when a variometer error occurs.
+	 *
+	 * @pre callback is not NULL
+	 * @post callback is added to the list of error callbacks.
+	 *
+	 * @param[in] callback
+	 * 	The callback function pointer to register on the "error" callback list.
+	 */
+	void (*registerErrorCb)(const VariometerErrorCb callback);
+
+	/** Remove a registered VariometerErrorCb function
+	 *
+	 * This function will remove a callback function from the registered list of
+	 * "error" callbacks. If the function has not been previously registered,
+	 * the parameter will be ignored and the list will be unchanged.
+	 *
+	 * @post callback function pointer is not present on the list of "error" callbacks.
+	 *
+	 * @param[in] callback
+	 * 	The callback function pointer to remove from the "error" callback list.
+	 */
+	void (*unregisterErrorCb)(const VariometerErrorCb callback);
+} Variometer_withCb;
+
+#endif // VIRTUAL_VARIOMETER_H_